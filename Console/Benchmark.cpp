@@ -0,0 +1,309 @@
+#include "Benchmark.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+#include <new>
+
+using namespace Bench;
+
+namespace
+{
+	std::atomic<std::size_t> globalAllocationCount	= 0;
+	std::atomic<std::size_t> globalAllocationBytes	= 0;
+
+	void* Allocate(std::size_t aSize)
+	{
+		globalAllocationCount.fetch_add(1, std::memory_order_relaxed);
+		globalAllocationBytes.fetch_add(aSize, std::memory_order_relaxed);
+
+		if (void* memory = std::malloc(aSize != 0 ? aSize : 1))
+			return memory;
+
+		throw std::bad_alloc();
+	}
+
+	void* AllocateAligned(std::size_t aSize, std::align_val_t aAlignment)
+	{
+		globalAllocationCount.fetch_add(1, std::memory_order_relaxed);
+		globalAllocationBytes.fetch_add(aSize, std::memory_order_relaxed);
+
+		const std::size_t alignment = static_cast<std::size_t>(aAlignment);
+
+#ifdef _MSC_VER
+		if (void* memory = _aligned_malloc(aSize != 0 ? aSize : 1, alignment))
+			return memory;
+#else
+		const std::size_t size = ((aSize != 0 ? aSize : 1) + alignment - 1) / alignment * alignment;
+
+		if (void* memory = std::aligned_alloc(alignment, size))
+			return memory;
+#endif
+
+		throw std::bad_alloc();
+	}
+
+	void DeallocateAligned(void* aMemory) noexcept
+	{
+#ifdef _MSC_VER
+		_aligned_free(aMemory);
+#else
+		std::free(aMemory);
+#endif
+	}
+
+	std::string EscapeJSON(std::string_view aText)
+	{
+		std::string result;
+		result.reserve(aText.size());
+
+		for (const char character : aText)
+		{
+			if (character == '"' || character == '\\')
+				result += '\\';
+
+			result += character;
+		}
+
+		return result;
+	}
+
+	/// Quotes the field if it contains a separator, a quote or a line break, quotes are then doubled
+	/// 
+	std::string EscapeCSV(std::string_view aText)
+	{
+		if (aText.find_first_of(",\"\r\n") == std::string_view::npos)
+			return std::string(aText);
+
+		std::string result = "\"";
+
+		for (const char character : aText)
+		{
+			if (character == '"')
+				result += '"';
+
+			result += character;
+		}
+
+		return result += '"';
+	}
+
+	/// Splits a line written with EscapeCSV back into its fields
+	/// 
+	std::vector<std::string> ParseCSVLine(std::string_view aLine)
+	{
+		std::vector<std::string> fields(1);
+		bool isQuoted = false;
+
+		for (std::size_t i = 0; i < aLine.size(); ++i)
+		{
+			const char character = aLine[i];
+
+			if (isQuoted && character == '"' && i + 1 < aLine.size() && aLine[i + 1] == '"')
+			{
+				fields.back() += '"';
+				++i;
+			}
+			else if (character == '"')
+			{
+				isQuoted = !isQuoted;
+			}
+			else if (character == ',' && !isQuoted)
+			{
+				fields.emplace_back();
+			}
+			else if (character != '\r')
+			{
+				fields.back() += character;
+			}
+		}
+
+		return fields;
+	}
+
+	std::string MakeKey(std::string_view aName, std::string_view aOperation, std::string_view aSize)
+	{
+		std::string key;
+		key.append(aName).append("|").append(aOperation).append("|").append(aSize);
+
+		return key;
+	}
+}
+
+void* operator new(std::size_t aSize) { return Allocate(aSize); }
+void* operator new[](std::size_t aSize) { return Allocate(aSize); }
+void* operator new(std::size_t aSize, std::align_val_t aAlignment) { return AllocateAligned(aSize, aAlignment); }
+void* operator new[](std::size_t aSize, std::align_val_t aAlignment) { return AllocateAligned(aSize, aAlignment); }
+
+void operator delete(void* aMemory) noexcept { std::free(aMemory); }
+void operator delete[](void* aMemory) noexcept { std::free(aMemory); }
+void operator delete(void* aMemory, std::size_t) noexcept { std::free(aMemory); }
+void operator delete[](void* aMemory, std::size_t) noexcept { std::free(aMemory); }
+void operator delete(void* aMemory, std::align_val_t) noexcept { DeallocateAligned(aMemory); }
+void operator delete[](void* aMemory, std::align_val_t) noexcept { DeallocateAligned(aMemory); }
+void operator delete(void* aMemory, std::size_t, std::align_val_t) noexcept { DeallocateAligned(aMemory); }
+void operator delete[](void* aMemory, std::size_t, std::align_val_t) noexcept { DeallocateAligned(aMemory); }
+
+AllocationStats Bench::GetAllocationStats() noexcept
+{
+	return { globalAllocationCount.load(std::memory_order_relaxed), globalAllocationBytes.load(std::memory_order_relaxed) };
+}
+
+Options Bench::ParseOptions(int aArgc, char* aArgv[])
+{
+	Options options;
+
+	for (int i = 1; i < aArgc; ++i)
+	{
+		const std::string_view argument = aArgv[i];
+		const char* value = (i + 1 < aArgc) ? aArgv[i + 1] : nullptr;
+
+		if (value == nullptr)
+		{
+			std::cerr << "Missing value for " << argument << '\n';
+			std::exit(2);
+		}
+
+		if (argument == "--filter")
+			options.filter = value;
+		else if (argument == "--csv")
+			options.csvPath = value;
+		else if (argument == "--json")
+			options.jsonPath = value;
+		else if (argument == "--baseline")
+			options.baselinePath = value;
+		else if (argument == "--min-time")
+			options.minTimeMs = std::atof(value);
+		else if (argument == "--threshold")
+			options.regressionThreshold = std::atof(value);
+		else
+		{
+			std::cerr << "Unknown argument " << argument << '\n';
+			std::exit(2);
+		}
+
+		++i;
+	}
+
+	return options;
+}
+
+Runner::Runner(Options aOptions)
+	: myOptions(std::move(aOptions))
+{
+	std::printf("%-28s %-10s %-6s %12s %12s %10s %10s\n", "case", "op", "size", "bytes", "ns/op", "GB/s", "allocs/op");
+}
+
+bool Runner::IsFiltered(std::string_view aName, std::string_view aOperation, std::string_view aSize) const
+{
+	if (myOptions.filter.empty())
+		return false;
+
+	return MakeKey(aName, aOperation, aSize).find(myOptions.filter) == std::string::npos;
+}
+
+void Runner::Record(Result&& aResult)
+{
+	std::printf("%-28s %-10s %-6s %12zu %12.1f %10.3f %10.2f\n", aResult.name.c_str(), aResult.operation.c_str(), aResult.size.c_str(),
+		aResult.payloadBytes, aResult.nsPerOp, aResult.gbPerSecond, aResult.allocationsPerOp);
+
+	std::fflush(stdout);
+
+	myResults.push_back(std::move(aResult));
+}
+
+void Runner::RecordMismatch(std::string_view aName, std::string_view aOperation, std::string_view aSize)
+{
+	std::printf("%-28s %-10s %-6s  MISMATCH: the decoded data differs from the input\n", std::string(aName).c_str(), std::string(aOperation).c_str(), std::string(aSize).c_str());
+	std::fflush(stdout);
+
+	++myNumMismatches;
+}
+
+void Runner::WriteCSV(const std::string& aPath) const
+{
+	std::ofstream file(aPath);
+
+	file << "name,operation,size,payload_bytes,iterations,ns_per_op,gb_per_s,allocs_per_op\n";
+
+	for (const Result& result : myResults)
+	{
+		file << EscapeCSV(result.name) << ',' << EscapeCSV(result.operation) << ',' << EscapeCSV(result.size) << ',' << result.payloadBytes << ',' << result.iterations << ','
+			 << result.nsPerOp << ',' << result.gbPerSecond << ',' << result.allocationsPerOp << '\n';
+	}
+}
+
+void Runner::WriteJSON(const std::string& aPath) const
+{
+	std::ofstream file(aPath);
+
+	file << "[\n";
+
+	for (std::size_t i = 0; i < myResults.size(); ++i)
+	{
+		const Result& result = myResults[i];
+
+		file << "  { \"name\": \"" << EscapeJSON(result.name) << "\", \"operation\": \"" << result.operation << "\", \"size\": \"" << result.size
+			 << "\", \"payload_bytes\": " << result.payloadBytes << ", \"iterations\": " << result.iterations << ", \"ns_per_op\": " << result.nsPerOp
+			 << ", \"gb_per_s\": " << result.gbPerSecond << ", \"allocs_per_op\": " << result.allocationsPerOp << " }"
+			 << (i + 1 != myResults.size() ? ",\n" : "\n");
+	}
+
+	file << "]\n";
+}
+
+std::size_t Runner::CompareToBaseline(const std::string& aPath) const
+{
+	std::ifstream file(aPath);
+
+	if (!file)
+	{
+		std::cerr << "Could not open baseline " << aPath << '\n';
+		return 0;
+	}
+
+	std::unordered_map<std::string, double> baseline;
+
+	std::string line;
+	std::getline(file, line); // header
+
+	while (std::getline(file, line))
+	{
+		const std::vector<std::string> fields = ParseCSVLine(line);
+
+		if (fields.size() < 6)
+			continue;
+
+		baseline[MakeKey(fields[0], fields[1], fields[2])] = std::atof(fields[5].c_str()); // name, operation, size, payload_bytes, iterations, ns_per_op
+	}
+
+	std::printf("\n%-28s %-10s %-6s %12s %12s %9s\n", "case", "op", "size", "base ns/op", "ns/op", "change");
+
+	std::size_t numRegressions = 0;
+
+	for (const Result& result : myResults)
+	{
+		const auto it = baseline.find(MakeKey(result.name, result.operation, result.size));
+
+		if (it == baseline.end() || it->second <= 0.0)
+		{
+			std::printf("%-28s %-10s %-6s %12s %12.1f %9s  NO BASELINE\n", result.name.c_str(), result.operation.c_str(), result.size.c_str(),
+				"-", result.nsPerOp, "-");
+
+			continue;
+		}
+
+		const double change = result.nsPerOp / it->second - 1.0;
+		const bool isRegression = change > myOptions.regressionThreshold;
+
+		numRegressions += isRegression;
+
+		std::printf("%-28s %-10s %-6s %12.1f %12.1f %+8.1f%%%s\n", result.name.c_str(), result.operation.c_str(), result.size.c_str(),
+			it->second, result.nsPerOp, change * 100.0, isRegression ? "  REGRESSION" : "");
+	}
+
+	return numRegressions;
+}
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+
+#include <DaiSer/Config.h>
+
+/// Minimal benchmark harness, each case is run in batches until a minimum time has passed and the
+/// median of the batches is reported. Allocations are counted by replacing the global operator new.
+/// 
+/// Building on Linux, from the repository root:
+/// 
+///		g++ -std=c++20 -O2 -DNDEBUG -DDAISER_STATIC -I DaiSer/include -include DaiSer/DaiSer.pch.h DaiSer/src/*.cpp DaiSer/src/*/*.cpp Console/*.cpp -o DaiSerBench -lpthread
+/// 
+/// Usage: DaiSerBench [--filter text] [--min-time ms] [--csv file] [--json file] [--baseline file] [--threshold ratio]
+
+namespace Bench
+{
+	struct AllocationStats
+	{
+		std::size_t count	= 0;
+		std::size_t bytes	= 0;
+	};
+
+	/// Total number of allocations made through the global operator new since the program started
+	/// 
+	NODISC AllocationStats GetAllocationStats() noexcept;
+
+	/// Prevents the compiler from optimizing away the computation of the value
+	/// 
+	template<typename T>
+	inline void DoNotOptimize(const T& aValue)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(aValue) : "memory");
+#else
+		static volatile const void* sink;
+		sink = &aValue;
+#endif
+	}
+
+	struct Result
+	{
+		std::string name;
+		std::string operation;
+		std::string size;
+		std::size_t payloadBytes		= 0;
+		std::size_t iterations			= 0;
+		double		nsPerOp				= 0.0;
+		double		gbPerSecond			= 0.0;
+		double		allocationsPerOp	= 0.0;
+	};
+
+	struct Options
+	{
+		std::string filter;
+		std::string csvPath;
+		std::string jsonPath;
+		std::string baselinePath;
+		double		minTimeMs			= 200.0;
+		double		regressionThreshold	= 0.10; // relative slowdown in ns/op that counts as a regression
+	};
+
+	NODISC Options ParseOptions(int aArgc, char* aArgv[]);
+
+	class Runner
+	{
+	public:
+		explicit Runner(Options aOptions);
+
+		/// Measures aOperation, which processes aPayloadBytes bytes each time it is called
+		/// 
+		template<typename Func>
+		void Run(std::string_view aName, std::string_view aOperation, std::string_view aSize, std::size_t aPayloadBytes, Func&& aFunc);
+
+		/// Reports the case as a mismatch when aIsMatch returns false, it is only called for cases that were run
+		/// 
+		template<typename Func>
+		void Verify(std::string_view aName, std::string_view aOperation, std::string_view aSize, Func&& aIsMatch);
+
+		NODISC const std::vector<Result>& GetResults() const noexcept { return myResults; }
+		NODISC std::size_t GetNumMismatches() const noexcept { return myNumMismatches; }
+
+		void WriteCSV(const std::string& aPath) const;
+		void WriteJSON(const std::string& aPath) const;
+
+		/// Prints the change against a CSV written by an earlier run, returns the number of regressions
+		/// 
+		NODISC std::size_t CompareToBaseline(const std::string& aPath) const;
+
+	private:
+		NODISC bool IsFiltered(std::string_view aName, std::string_view aOperation, std::string_view aSize) const;
+
+		void Record(Result&& aResult);
+		void RecordMismatch(std::string_view aName, std::string_view aOperation, std::string_view aSize);
+
+		Options				myOptions;
+		std::vector<Result>	myResults;
+		std::size_t			myNumMismatches = 0;
+	};
+
+	template<typename Func>
+	inline void Runner::Run(std::string_view aName, std::string_view aOperation, std::string_view aSize, std::size_t aPayloadBytes, Func&& aFunc)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		static constexpr std::size_t NUM_SAMPLES = 5;
+
+		if (IsFiltered(aName, aOperation, aSize))
+			return;
+
+		aFunc(); // warm up caches and buffers
+
+		// find how many iterations fill a sample
+		const double sampleTimeNs = myOptions.minTimeMs * 1e6 / NUM_SAMPLES;
+
+		std::size_t iterations = 1;
+		for (;;)
+		{
+			const auto start = Clock::now();
+
+			for (std::size_t i = 0; i < iterations; ++i)
+				aFunc();
+
+			const double elapsedNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+
+			if (elapsedNs >= sampleTimeNs / 10.0 || iterations >= (std::size_t(1) << 30))
+			{
+				iterations = std::max<std::size_t>(1, static_cast<std::size_t>(iterations * sampleTimeNs / std::max(elapsedNs, 1.0)));
+				break;
+			}
+
+			iterations *= 2;
+		}
+
+		std::vector<double> samples;
+		samples.reserve(NUM_SAMPLES);
+
+		const AllocationStats allocsBefore = GetAllocationStats();
+
+		for (std::size_t sample = 0; sample < NUM_SAMPLES; ++sample)
+		{
+			const auto start = Clock::now();
+
+			for (std::size_t i = 0; i < iterations; ++i)
+				aFunc();
+
+			const double elapsedNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+			samples.push_back(elapsedNs / static_cast<double>(iterations));
+		}
+
+		const AllocationStats allocsAfter = GetAllocationStats();
+
+		std::nth_element(samples.begin(), samples.begin() + NUM_SAMPLES / 2, samples.end());
+
+		Result result;
+		result.name				= aName;
+		result.operation		= aOperation;
+		result.size				= aSize;
+		result.payloadBytes		= aPayloadBytes;
+		result.iterations		= iterations * NUM_SAMPLES;
+		result.nsPerOp			= samples[NUM_SAMPLES / 2];
+		result.gbPerSecond		= static_cast<double>(aPayloadBytes) / result.nsPerOp; // bytes per ns is GB/s
+		result.allocationsPerOp	= static_cast<double>(allocsAfter.count - allocsBefore.count) / static_cast<double>(result.iterations);
+
+		Record(std::move(result));
+	}
+
+	template<typename Func>
+	inline void Runner::Verify(std::string_view aName, std::string_view aOperation, std::string_view aSize, Func&& aIsMatch)
+	{
+		if (!IsFiltered(aName, aOperation, aSize) && !aIsMatch())
+			RecordMismatch(aName, aOperation, aSize);
+	}
+}
@@ -1,10 +1,986 @@
 #include <iostream>
 #include <string>
 #include <array>
+#include <algorithm>
+#include <vector>
+#include <tuple>
+#include <utility>
 
-#include <DaiSer.h>
+#include <DaiSer/DaiSer.h>
 
-int main()
+#include "Benchmark.h"
+
+using namespace DaiSer;
+
+namespace
 {
+	struct PayloadSize
+	{
+		const char*	name;
+		std::size_t	approxBytes;
+	};
+
+	constexpr std::array<PayloadSize, 3> PAYLOAD_SIZES
+	{
+		PayloadSize{ "small",	64 },
+		PayloadSize{ "medium",	64 * 1024 },
+		PayloadSize{ "large",	16 * 1024 * 1024 }
+	};
+
+	struct Entity
+	{
+		std::int32_t		id;
+		float				health;
+		std::string			name;
+		std::vector<int>	inventory;
+
+		friend bool operator==(const Entity&, const Entity&) = default;
+	};
+
+	struct Telemetry
+	{
+		std::uint64_t	timestamp;
+		std::uint32_t	sensor;
+		double			value;
+		std::uint8_t	status;
+		float			x;
+		float			y;
+		std::int16_t	temperature;
+		double			voltage;
+		std::uint8_t	flags;
+
+		friend bool operator==(const Telemetry&, const Telemetry&) = default;
+	};
+
+	struct EmptyPayload {}; // written without being measured and as nothing at all
+}
+
+template<>
+struct DaiSer::SerializeImpl<EmptyPayload>
+{
+	template<ByteSink Sink>
+	NODISC std::size_t Write(const EmptyPayload&, Sink&, std::size_t) { return 0; }
+
+	NODISC std::size_t Read(EmptyPayload&, std::span<const std::byte>, std::size_t) { return 0; }
+};
+
+namespace
+{
+
+	std::string MakeString(std::size_t aIndex, std::size_t aLength)
+	{
+		std::string result(aLength, 'a');
+
+		for (std::size_t i = 0; i < aLength; ++i)
+			result[i] = static_cast<char>('a' + (aIndex + i) % 26);
+
+		return result;
+	}
+
+	std::wstring MakeWString(std::size_t aIndex, std::size_t aLength)
+	{
+		std::wstring result(aLength, L'a');
+
+		for (std::size_t i = 0; i < aLength; ++i)
+			result[i] = static_cast<wchar_t>(L'a' + (aIndex + i) % 26);
+
+		return result;
+	}
+
+	/// Measures writing the data into a reused WriteSerializer and reading it back into a reused object
+	/// 
+	template<typename T>
+	void BenchmarkValue(Bench::Runner& aRunner, std::string_view aName, std::string_view aSize, const T& aData)
+	{
+		WriteSerializer writer;
+		writer << aData;
+
+		const std::size_t payloadBytes = writer.GetBuffer().size();
+
+		aRunner.Run(aName, "write", aSize, payloadBytes, [&]()
+		{
+			writer.Clear();
+			writer << aData;
+			Bench::DoNotOptimize(writer.GetBufferData());
+		});
+
+		const ByteBuffer buffer = writer.MoveBuffer();
+
+		T result{};
+		aRunner.Run(aName, "read", aSize, payloadBytes, [&]()
+		{
+			ReadSerializer reader(static_cast<std::span<const std::byte>>(buffer));
+			reader >> result;
+			Bench::DoNotOptimize(result);
+		});
+
+		aRunner.Verify(aName, "read", aSize, [&]() { return result == aData; });
+	}
+
+	/// Measures writing and reading the values one by one, which is dominated by per-call overhead
+	/// 
+	template<typename T>
+	void BenchmarkScalars(Bench::Runner& aRunner, std::string_view aName, std::string_view aSize, const std::vector<T>& aData)
+	{
+		WriteSerializer writer;
+		for (const T& value : aData)
+			writer << value;
+
+		const std::size_t payloadBytes = writer.GetBuffer().size();
+
+		aRunner.Run(aName, "write", aSize, payloadBytes, [&]()
+		{
+			writer.Clear();
+
+			for (const T& value : aData)
+				writer << value;
+
+			Bench::DoNotOptimize(writer.GetBufferData());
+		});
+
+		const ByteBuffer buffer = writer.MoveBuffer();
+
+		aRunner.Run(aName, "read", aSize, payloadBytes, [&]()
+		{
+			ReadSerializer reader(static_cast<std::span<const std::byte>>(buffer));
+
+			T value{};
+			for (std::size_t i = 0; i < aData.size(); ++i)
+			{
+				reader >> value;
+				Bench::DoNotOptimize(value);
+			}
+		});
+
+		aRunner.Verify(aName, "read", aSize, [&]()
+		{
+			ReadSerializer reader(static_cast<std::span<const std::byte>>(buffer));
+
+			std::vector<T> result(aData.size());
+			for (T& value : result)
+				reader >> value;
+
+			return result == aData;
+		});
+	}
+
+	/// Measures reading nested containers into fresh objects, with the default heap versus a per-message arena
+	/// 
+	void BenchmarkArena(Bench::Runner& aRunner, std::string_view aSize, const std::vector<std::vector<std::string>>& aData)
+	{
+		WriteSerializer writer;
+		writer << aData;
+
+		const ByteBuffer buffer = writer.MoveBuffer();
+		const std::span<const std::byte> bytes = buffer;
+
+		aRunner.Run("vector<vector<string>>", "read", aSize, bytes.size(), [&]()
+		{
+			ReadSerializer reader(bytes);
+
+			std::vector<std::vector<std::string>> result;
+			reader >> result;
+
+			Bench::DoNotOptimize(result.data());
+		});
+
+		aRunner.Verify("vector<vector<string>>", "read", aSize, [&]()
+		{
+			ReadSerializer reader(bytes);
+
+			std::vector<std::vector<std::string>> result;
+			reader >> result;
+
+			return result == aData;
+		});
+
+		aRunner.Run("pmr<vector<vector<string>>>", "read", aSize, bytes.size(), [&]()
+		{
+			DeserializeArena arena(bytes);
+			ReadSerializer reader(bytes);
+
+			const auto result = reader.Deserialize<std::pmr::vector<std::pmr::vector<std::pmr::string>>>(arena.GetResource());
+
+			Bench::DoNotOptimize(result.data());
+		});
+
+		aRunner.Verify("pmr<vector<vector<string>>>", "read", aSize, [&]()
+		{
+			DeserializeArena arena(bytes);
+			ReadSerializer reader(bytes);
+
+			const auto result = reader.Deserialize<std::pmr::vector<std::pmr::vector<std::pmr::string>>>(arena.GetResource());
+
+			return std::ranges::equal(result, aData, [](const auto& aLeft, const auto& aRight)
+			{
+				return std::ranges::equal(aLeft, aRight, [](std::string_view aLeftString, std::string_view aRightString) { return aLeftString == aRightString; });
+			});
+		});
+	}
+
+	/// Measures the compression stage on the serialized data, the payload is the uncompressed size
+	/// 
+	template<typename T>
+	void BenchmarkCompression(Bench::Runner& aRunner, std::string_view aName, std::string_view aSize, const T& aData)
+	{
+		WriteSerializer writer;
+		writer << aData;
+
+		const std::span<const std::byte> bytes = writer.GetBuffer();
+
+		aRunner.Run(aName, "compress", aSize, bytes.size(), [&]()
+		{
+			const ByteBuffer compressed = Compress(bytes);
+			Bench::DoNotOptimize(compressed.GetData());
+		});
+
+		const ByteBuffer compressed = Compress(bytes);
+
+		aRunner.Run(aName, "decompress", aSize, bytes.size(), [&]()
+		{
+			const ByteBuffer result = Decompress(compressed);
+			Bench::DoNotOptimize(result.GetData());
+		});
+
+		aRunner.Verify(aName, "decompress", aSize, [&]() { return std::ranges::equal(static_cast<std::span<const std::byte>>(Decompress(compressed)), bytes); });
+	}
+
+	/// Measures reading the data after verifying a checksum trailer, to compare against the plain read
+	/// 
+	template<typename T>
+	void BenchmarkChecksum(Bench::Runner& aRunner, std::string_view aName, std::string_view aSize, const T& aData)
+	{
+		WriteSerializer writer;
+		writer << aData;
+		writer.AppendChecksum();
+
+		const ByteBuffer buffer = writer.MoveBuffer();
+
+		T result{};
+		aRunner.Run(aName, "read+crc", aSize, buffer.GetSize(), [&]()
+		{
+			ReadSerializer reader(static_cast<std::span<const std::byte>>(buffer));
+			reader.VerifyChecksum();
+			reader >> result;
+			Bench::DoNotOptimize(result);
+		});
+
+		aRunner.Verify(aName, "read+crc", aSize, [&]() { return result == aData; });
+	}
+
+	void BenchmarkDSStream(Bench::Runner& aRunner, std::string_view aSize, std::vector<Entity> aData) // copied since DSScope takes mutable references
+	{
+		const auto Write = [&aData]()
+		{
+			ODSStream out;
+			DSScope scope = out;
+
+			FieldIDType id = 0;
+			for (Entity& entity : aData)
+			{
+				scope.Serialize(id++, entity.id);
+				scope.Serialize(id++, entity.health);
+				scope.Serialize(id++, entity.name);
+				scope.Serialize(id++, entity.inventory);
+			}
+
+			return out.MoveBuffer();
+		};
+
+		const ByteBuffer buffer = Write();
+		const std::size_t payloadBytes = buffer.GetSize();
+
+		aRunner.Run("dsstream<entity>", "write", aSize, payloadBytes, [&]()
+		{
+			const ByteBuffer result = Write();
+			Bench::DoNotOptimize(result.GetData());
+		});
+
+		std::vector<Entity> result(aData.size());
+		aRunner.Run("dsstream<entity>", "read", aSize, payloadBytes, [&]()
+		{
+			IDSStream in(static_cast<std::span<const std::byte>>(buffer));
+			DSScope scope = in;
+
+			FieldIDType id = 0;
+			for (Entity& entity : result)
+			{
+				scope.Serialize(id++, entity.id);
+				scope.Serialize(id++, entity.health);
+				scope.Serialize(id++, entity.name);
+				scope.Serialize(id++, entity.inventory);
+			}
+
+			Bench::DoNotOptimize(result.data());
+		});
+
+		aRunner.Verify("dsstream<entity>", "read", aSize, [&]() { return result == aData; });
+
+		// every entity as its own message, written in another field order than the reader declares
+
+		using WriterFields = FieldSet<Field<4, &Entity::inventory>, Field<3, &Entity::name>, Field<2, &Entity::health>, Field<1, &Entity::id>>;
+		using ReaderFields = FieldSet<Field<1, &Entity::id>, Field<2, &Entity::health>, Field<3, &Entity::name>, Field<4, &Entity::inventory>>;
+
+		std::vector<ByteBuffer> messages;
+		std::size_t messageBytes = 0;
+
+		std::ranges::fill(result, Entity{}); // the reordered fields are checked on their own
+
+		for (Entity& entity : aData)
+		{
+			ODSStream out;
+			out.Start().SerializeFields<WriterFields>(entity);
+
+			messageBytes += out.GetBuffer().size();
+			messages.emplace_back(out.MoveBuffer());
+		}
+
+		aRunner.Run("dsstream<entity>", "fields", aSize, messageBytes, [&]()
+		{
+			for (std::size_t i = 0; i < messages.size(); ++i)
+			{
+				IDSStream in(static_cast<std::span<const std::byte>>(messages[i]));
+				in.Start().SerializeFields<ReaderFields>(result[i]);
+			}
+
+			Bench::DoNotOptimize(result.data());
+		});
+
+		aRunner.Verify("dsstream<entity>", "fields", aSize, [&]() { return result == aData; });
+	}
+
+	/// Measures a field with an empty payload that is not measured before it is written, placed after a
+	/// string that fills the first allocation of the stream so that its length lands on the boundary
+	/// 
+	void BenchmarkEmptyField(Bench::Runner& aRunner)
+	{
+		std::string		name(60, 'n'); // field header, field length, string length and characters end one byte short of 64
+		EmptyPayload	empty;
+		std::int32_t	id = 42;
+
+		const auto Write = [&]()
+		{
+			ODSStream out;
+			DSScope scope = out;
+
+			scope.Serialize(0, name);
+			scope.Serialize(1, empty);
+			scope.Serialize(2, id);
+
+			return out.MoveBuffer();
+		};
+
+		const ByteBuffer buffer = Write();
+
+		aRunner.Run("dsstream<empty>", "write", "small", buffer.GetSize(), [&]()
+		{
+			const ByteBuffer result = Write();
+			Bench::DoNotOptimize(result.GetData());
+		});
+
+		std::string		nameResult;
+		std::int32_t	idResult = 0;
+
+		aRunner.Run("dsstream<empty>", "read", "small", buffer.GetSize(), [&]()
+		{
+			IDSStream in(static_cast<std::span<const std::byte>>(buffer));
+			DSScope scope = in;
+
+			EmptyPayload emptyResult;
+
+			scope.Serialize(0, nameResult);
+			scope.Serialize(1, emptyResult);
+			scope.Serialize(2, idResult);
+
+			Bench::DoNotOptimize(idResult);
+		});
+
+		aRunner.Verify("dsstream<empty>", "read", "small", [&]() { return nameResult == name && idResult == id; });
+	}
+
+	/// Measures writing only the fields that changed since the previous tick, and patching them onto the previous state
+	/// 
+	void BenchmarkDelta(Bench::Runner& aRunner, std::string_view aSize, const std::vector<Entity>& aBaseline)
+	{
+		std::vector<Entity> current = aBaseline;
+		for (std::size_t i = 0; i < current.size(); i += 10) // a tenth of the entities change a single field
+			current[i].health += 1.0f;
+
+		const auto Write = [&]()
+		{
+			ODSStream out;
+			DSScope scope = out;
+
+			FieldIDType id = 0;
+			for (std::size_t i = 0; i < current.size(); ++i)
+			{
+				scope.SerializeDelta(id++, current[i].id, aBaseline[i].id);
+				scope.SerializeDelta(id++, current[i].health, aBaseline[i].health);
+				scope.SerializeDelta(id++, current[i].name, aBaseline[i].name);
+				scope.SerializeDelta(id++, current[i].inventory, aBaseline[i].inventory);
+			}
+
+			return out.MoveBuffer();
+		};
+
+		const ByteBuffer buffer = Write();
+		const std::size_t payloadBytes = buffer.GetSize();
+
+		aRunner.Run("delta<entity>", "write", aSize, payloadBytes, [&]()
+		{
+			const ByteBuffer result = Write();
+			Bench::DoNotOptimize(result.GetData());
+		});
+
+		std::vector<Entity> result = aBaseline;
+		aRunner.Run("delta<entity>", "read", aSize, payloadBytes, [&]()
+		{
+			IDSStream in(static_cast<std::span<const std::byte>>(buffer));
+			DSScope scope = in;
+
+			FieldIDType id = 0;
+			for (std::size_t i = 0; i < result.size(); ++i)
+			{
+				scope.SerializeDelta(id++, result[i].id, aBaseline[i].id);
+				scope.SerializeDelta(id++, result[i].health, aBaseline[i].health);
+				scope.SerializeDelta(id++, result[i].name, aBaseline[i].name);
+				scope.SerializeDelta(id++, result[i].inventory, aBaseline[i].inventory);
+			}
+
+			Bench::DoNotOptimize(result.data());
+		});
+
+		aRunner.Verify("delta<entity>", "read", aSize, [&]() { return result == current; });
+	}
+
+	/// Measures sending every entity as its own message, serialized into separate buffers that are copied into
+	/// a send buffer, versus framed into a batch and gathered, and splitting the received frames back up
+	/// 
+	void BenchmarkFrames(Bench::Runner& aRunner, std::string_view aSize, const std::vector<Entity>& aData)
+	{
+		std::vector<std::byte> sendBuffer;
+		std::array<IoSlice, 64> slices;
+
+		const auto Send = [&sendBuffer](std::span<const std::byte> aBytes)
+		{
+			sendBuffer.insert(sendBuffer.end(), aBytes.begin(), aBytes.end());
+		};
+
+		MessageBatch batch;
+		for (const Entity& entity : aData)
+			batch.Write(entity);
+
+		const std::size_t payloadBytes = batch.GetPendingBytes();
+
+		aRunner.Run("frames<entity>", "copy", aSize, payloadBytes, [&]()
+		{
+			sendBuffer.clear();
+
+			for (const Entity& entity : aData)
+			{
+				WriteSerializer writer;
+				writer << entity;
+
+				const ByteBuffer buffer = writer.MoveBuffer();
+
+				const std::uint32_t length = static_cast<std::uint32_t>(buffer.GetSize());
+				Send(std::as_bytes(std::span(&length, 1)));
+				Send(buffer);
+			}
+
+			Bench::DoNotOptimize(sendBuffer.data());
+		});
+
+		for (std::size_t i = 0, numSlices = batch.Gather(slices); i < numSlices; ++i)
+			Send({ static_cast<const std::byte*>(slices[i].base), slices[i].length });
+
+		const std::vector<std::byte> stream = sendBuffer;
+
+		batch.Consume(batch.GetPendingBytes());
+
+		aRunner.Run("frames<entity>", "batch", aSize, payloadBytes, [&]()
+		{
+			for (const Entity& entity : aData)
+				batch.Write(entity);
+
+			for (std::size_t numSlices = batch.Gather(slices); numSlices != 0; numSlices = batch.Gather(slices))
+			{
+				std::size_t numBytes = 0;
+				for (std::size_t i = 0; i < numSlices; ++i)
+					numBytes += slices[i].length;
+
+				Bench::DoNotOptimize(slices.data());
+				batch.Consume(numBytes);
+			}
+		});
+
+		std::vector<Entity> result(aData.size());
+		aRunner.Run("frames<entity>", "split", aSize, payloadBytes, [&]()
+		{
+			FrameReader reader(stream);
+
+			for (Entity& entity : result)
+				reader.Next()->Deserialize(entity);
+
+			Bench::DoNotOptimize(result.data());
+		});
+
+		aRunner.Verify("frames<entity>", "split", aSize, [&]() { return result == aData; });
+	}
+
+	/// Measures encoding every entity as a response with a fresh buffer each, versus borrowing buffers from the pool
+	/// 
+	void BenchmarkPool(Bench::Runner& aRunner, std::string_view aSize, const std::vector<Entity>& aData)
+	{
+		std::size_t payloadBytes = 0;
+		for (const Entity& entity : aData)
+			payloadBytes += SerializeImpl<Entity>{}.Size(entity);
+
+		aRunner.Run("responses<entity>", "fresh", aSize, payloadBytes, [&]()
+		{
+			for (const Entity& entity : aData)
+			{
+				WriteSerializer writer;
+				writer << entity;
+
+				const ByteBuffer buffer = writer.MoveBuffer();
+				Bench::DoNotOptimize(buffer.GetData());
+			}
+		});
+
+		aRunner.Run("responses<entity>", "pooled", aSize, payloadBytes, [&]()
+		{
+			for (const Entity& entity : aData)
+			{
+				WriteSerializer writer(BufferPool::Acquire());
+				writer << entity;
+
+				ByteBuffer buffer = writer.MoveBuffer();
+				Bench::DoNotOptimize(buffer.GetData());
+
+				BufferPool::Release(std::move(buffer));
+			}
+		});
+	}
+
+	/// Measures receiving entities in packet-sized pieces, either collecting every piece before decoding or
+	/// decoding each piece as it arrives
+	/// 
+	void BenchmarkIncremental(Bench::Runner& aRunner, std::string_view aSize, const std::vector<Entity>& aData)
+	{
+		constexpr std::size_t PACKET_SIZE = 1500;
+
+		WriteSerializer writer;
+		writer << aData;
+
+		const std::span<const std::byte> stream = writer.GetBuffer();
+
+		std::vector<std::byte> received;
+		std::vector<Entity> result;
+
+		aRunner.Run("stream<entity>", "whole", aSize, stream.size(), [&]()
+		{
+			received.clear();
+
+			for (std::size_t offset = 0; offset < stream.size(); offset += PACKET_SIZE)
+			{
+				const std::span<const std::byte> packet = stream.subspan(offset, std::min(PACKET_SIZE, stream.size() - offset));
+				received.insert(received.end(), packet.begin(), packet.end());
+			}
+
+			ReadSerializer reader(received);
+			reader >> result;
+
+			Bench::DoNotOptimize(result.data());
+		});
+
+		aRunner.Verify("stream<entity>", "whole", aSize, [&]() { return result == aData; });
+
+		result.clear();
+		bool isDone = false;
+
+		aRunner.Run("stream<entity>", "feed", aSize, stream.size(), [&]()
+		{
+			IncrementalReader reader;
+
+			DecodeTask task = [](IncrementalReader& aReader, std::vector<Entity>& aOutEntities) -> DecodeTask
+			{
+				co_await aReader.Read(aOutEntities);
+			}(reader, result);
+
+			for (std::size_t offset = 0; offset < stream.size(); offset += PACKET_SIZE)
+				reader.Feed(stream.subspan(offset, std::min(PACKET_SIZE, stream.size() - offset)));
+
+			isDone = task.IsDone();
+			Bench::DoNotOptimize(isDone);
+		});
+
+		aRunner.Verify("stream<entity>", "feed", aSize, [&]() { return isDone && result == aData; });
+	}
+
+	/// Measures strings drawn from a small set of labels written as they are and with a string table that 
+	/// is cleared for every message
+	/// 
+	void BenchmarkStringTable(Bench::Runner& aRunner, std::string_view aSize, const std::vector<std::string>& aData)
+	{
+		StringTable writeTable;
+		StringTable readTable;
+
+		for (const bool useTable : { false, true })
+		{
+			const std::string_view name = useTable ? "tags<table>" : "tags<plain>";
+
+			WriteSerializer writer;
+			writer.SetStringTable(useTable ? &writeTable : nullptr);
+			writer << aData;
+
+			const std::size_t payloadBytes = writer.GetBuffer().size();
+
+			aRunner.Run(name, "write", aSize, payloadBytes, [&]()
+			{
+				writeTable.Clear();
+				writer.Clear();
+				writer << aData;
+				Bench::DoNotOptimize(writer.GetBufferData());
+			});
+
+			const ByteBuffer buffer = writer.MoveBuffer();
+
+			std::vector<std::string> result;
+			aRunner.Run(name, "read", aSize, payloadBytes, [&]()
+			{
+				readTable.Clear();
+
+				ReadSerializer reader(static_cast<std::span<const std::byte>>(buffer));
+				reader.SetStringTable(useTable ? &readTable : nullptr);
+				reader >> result;
+
+				Bench::DoNotOptimize(result.data());
+			});
+
+			aRunner.Verify(name, "read", aSize, [&]() { return result == aData; });
+		}
+	}
+
+	/// Measures telemetry rows written as columns, reassembled as a whole and read one column at a time, 
+	/// against vector<telemetry> which copies the rows with their padding
+	/// 
+	void BenchmarkColumnar(Bench::Runner& aRunner, std::string_view aSize, const std::vector<Telemetry>& aData)
+	{
+		WriteSerializer writer;
+		writer << ColumnarVector(aData);
+
+		const std::size_t payloadBytes = writer.GetBuffer().size();
+
+		aRunner.Run("columns<telemetry>", "write", aSize, payloadBytes, [&]()
+		{
+			writer.Clear();
+			writer << ColumnarVector(aData);
+			Bench::DoNotOptimize(writer.GetBufferData());
+		});
+
+		const ByteBuffer buffer = writer.MoveBuffer();
+
+		std::vector<Telemetry> rows;
+		aRunner.Run("columns<telemetry>", "read", aSize, payloadBytes, [&]()
+		{
+			ReadSerializer reader(static_cast<std::span<const std::byte>>(buffer));
+
+			ColumnView<Telemetry> view;
+			reader >> view;
+
+			view.ToVector(rows);
+			Bench::DoNotOptimize(rows.data());
+		});
+
+		aRunner.Verify("columns<telemetry>", "read", aSize, [&]() { return rows == aData; });
+
+		std::vector<double> values;
+		aRunner.Run("columns<telemetry>", "read col", aSize, payloadBytes, [&]()
+		{
+			ReadSerializer reader(static_cast<std::span<const std::byte>>(buffer));
+
+			ColumnView<Telemetry> view;
+			reader >> view;
+
+			view.ReadColumn<2>(values);
+			Bench::DoNotOptimize(values.data());
+		});
+
+		aRunner.Verify("columns<telemetry>", "read col", aSize, [&]()
+		{
+			return std::ranges::equal(values, aData, {}, {}, &Telemetry::value);
+		});
+	}
+
+	/// Measures integers written bit-packed, to be compared with the same values written by BenchmarkValue
+	/// 
+	template<typename T>
+	void BenchmarkPacked(Bench::Runner& aRunner, std::string_view aName, std::string_view aSize, const std::vector<T>& aData)
+	{
+		WriteSerializer writer;
+		writer << PackedVector(aData);
+
+		const std::size_t payloadBytes = writer.GetBuffer().size();
+
+		aRunner.Run(aName, "write", aSize, payloadBytes, [&]()
+		{
+			writer.Clear();
+			writer << PackedVector(aData);
+			Bench::DoNotOptimize(writer.GetBufferData());
+		});
+
+		const ByteBuffer buffer = writer.MoveBuffer();
+
+		std::vector<T> values;
+		aRunner.Run(aName, "read", aSize, payloadBytes, [&]()
+		{
+			ReadSerializer reader(static_cast<std::span<const std::byte>>(buffer));
+
+			PackedView<T> view;
+			reader >> view;
+
+			view.ToVector(values);
+			Bench::DoNotOptimize(values.data());
+		});
+
+		aRunner.Verify(aName, "read", aSize, [&]() { return values == aData; });
+	}
+
+	/// Measures entities written as a snapshot, opened with a single lookup as a process would at startup and
+	/// scanned in place, against vector<entity> which decodes every entity before any can be used
+	/// 
+	void BenchmarkSnapshot(Bench::Runner& aRunner, std::string_view aSize, const std::vector<Entity>& aData)
+	{
+		ByteBuffer buffer;
+		WriteSnapshot(aData, buffer);
+
+		const std::size_t payloadBytes = buffer.GetSize();
+
+		aRunner.Run("snapshot<entity>", "write", aSize, payloadBytes, [&]()
+		{
+			WriteSnapshot(aData, buffer);
+			Bench::DoNotOptimize(buffer.GetData());
+		});
+
+		aRunner.Run("snapshot<entity>", "open", aSize, payloadBytes, [&]()
+		{
+			const SnapshotArray<Entity> entities = OpenSnapshot<std::vector<Entity>>(buffer);
+
+			const std::string_view name = entities[entities.GetSize() / 2].Get<2>();
+			Bench::DoNotOptimize(name.data());
+		});
+
+		aRunner.Run("snapshot<entity>", "scan", aSize, payloadBytes, [&]()
+		{
+			std::size_t total = 0;
+
+			for (const SnapshotView<Entity> entity : OpenSnapshot<std::vector<Entity>>(buffer))
+			{
+				for (const int item : entity.Get<3>())
+					total += static_cast<std::size_t>(item);
+
+				total += static_cast<std::size_t>(entity.Get<0>()) + entity.Get<2>().size();
+			}
+
+			Bench::DoNotOptimize(total);
+		});
+
+		aRunner.Verify("snapshot<entity>", "scan", aSize, [&]()
+		{
+			const SnapshotArray<Entity> entities = OpenSnapshot<std::vector<Entity>>(buffer);
+
+			if (entities.GetSize() != aData.size())
+				return false;
+
+			for (std::size_t i = 0; i < aData.size(); ++i)
+			{
+				const SnapshotView<Entity> entity = entities[i];
+
+				if (entity.Get<0>() != aData[i].id || entity.Get<1>() != aData[i].health || entity.Get<2>() != aData[i].name || 
+					!std::ranges::equal(entity.Get<3>(), aData[i].inventory))
+				{
+					return false;
+				}
+			}
+
+			return true;
+		});
+	}
+
+	std::vector<Entity> MakeEntities(std::size_t aCount)
+	{
+		std::vector<Entity> entities(aCount);
+
+		for (std::size_t i = 0; i < aCount; ++i)
+		{
+			entities[i].id			= static_cast<std::int32_t>(i);
+			entities[i].health		= static_cast<float>(i) * 0.5f;
+			entities[i].name		= MakeString(i, 8 + i % 16);
+			entities[i].inventory	= std::vector<int>(i % 8, static_cast<int>(i));
+		}
+
+		return entities;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const Bench::Options options = Bench::ParseOptions(argc, argv);
+
+	Bench::Runner runner(options);
+
+	BenchmarkEmptyField(runner);
+
+	for (const PayloadSize& size : PAYLOAD_SIZES)
+	{
+		const auto Count = [&size](std::size_t aApproxElementBytes)
+		{
+			return std::max<std::size_t>(1, size.approxBytes / aApproxElementBytes);
+		};
+
+		{
+			std::vector<std::int32_t> values(Count(sizeof(std::int32_t)));
+			for (std::size_t i = 0; i < values.size(); ++i)
+				values[i] = static_cast<std::int32_t>(i * 2654435761u);
+
+			BenchmarkScalars(runner, "scalar<int32>", size.name, values);
+		}
+
+		{
+			std::vector<double> values(Count(sizeof(double)));
+			for (std::size_t i = 0; i < values.size(); ++i)
+				values[i] = static_cast<double>(i) * 0.25;
+
+			BenchmarkScalars(runner, "scalar<double>", size.name, values);
+		}
+
+		{
+			std::vector<float> values(Count(sizeof(float)));
+			for (std::size_t i = 0; i < values.size(); ++i)
+				values[i] = static_cast<float>(i) * 0.5f;
+
+			BenchmarkValue(runner, "vector<float>", size.name, values);
+		}
+
+		{
+			std::vector<std::uint64_t> values(Count(sizeof(std::uint64_t)));
+			for (std::size_t i = 0; i < values.size(); ++i)
+				values[i] = i * i;
+
+			BenchmarkValue(runner, "vector<uint64>", size.name, values);
+			BenchmarkChecksum(runner, "vector<uint64>", size.name, values);
+		}
+
+		{
+			std::vector<std::uint64_t> timestamps(Count(sizeof(std::uint64_t)));
+			for (std::size_t i = 0; i < timestamps.size(); ++i)
+				timestamps[i] = 1'700'000'000'000 + i * 1000 + (i * 2654435761u) % 700;
+
+			BenchmarkValue(runner, "vector<timestamp>", size.name, timestamps);
+			BenchmarkPacked(runner, "packed<timestamp>", size.name, timestamps);
+		}
+
+		{
+			BenchmarkValue(runner, "string", size.name, MakeString(0, size.approxBytes));
+
+			std::vector<std::string> strings(Count(24));
+			for (std::size_t i = 0; i < strings.size(); ++i)
+				strings[i] = MakeString(i, 8 + i % 24);
+
+			BenchmarkValue(runner, "vector<string>", size.name, strings);
+
+			std::vector<std::vector<std::string>> nested(Count(8 * 24));
+			for (std::size_t i = 0; i < nested.size(); ++i)
+				nested[i].assign(strings.begin() + i * 8 % strings.size(), strings.begin() + std::min(i * 8 % strings.size() + 8, strings.size()));
+
+			BenchmarkArena(runner, size.name, nested);
+
+			std::vector<std::string> tags(Count(16));
+			for (std::size_t i = 0; i < tags.size(); ++i)
+				tags[i] = MakeString(i % 300, 8 + i % 300 % 16);
+
+			BenchmarkStringTable(runner, size.name, tags);
+		}
+
+		{
+			BenchmarkValue(runner, "wstring", size.name, MakeWString(0, Count(sizeof(wchar_t))));
+
+			std::vector<std::wstring> strings(Count(24 * sizeof(wchar_t)));
+			for (std::size_t i = 0; i < strings.size(); ++i)
+				strings[i] = MakeWString(i, 8 + i % 24);
+
+			BenchmarkValue(runner, "vector<wstring>", size.name, strings);
+		}
+
+		{
+			std::vector<std::vector<int>> nested(Count(16 * sizeof(int)));
+			for (std::size_t i = 0; i < nested.size(); ++i)
+				nested[i] = std::vector<int>(16, static_cast<int>(i));
+
+			BenchmarkValue(runner, "vector<vector<int>>", size.name, nested);
+		}
+
+		{
+			std::vector<std::pair<std::string, std::int32_t>> pairs(Count(20));
+			for (std::size_t i = 0; i < pairs.size(); ++i)
+				pairs[i] = { MakeString(i, 12), static_cast<std::int32_t>(i) };
+
+			BenchmarkValue(runner, "vector<pair<string,int>>", size.name, pairs);
+		}
+
+		{
+			std::vector<std::tuple<std::int32_t, double, std::string>> tuples(Count(28));
+			for (std::size_t i = 0; i < tuples.size(); ++i)
+				tuples[i] = { static_cast<std::int32_t>(i), static_cast<double>(i), MakeString(i, 12) };
+
+			BenchmarkValue(runner, "vector<tuple<int,dbl,str>>", size.name, tuples);
+		}
+
+		{
+			std::vector<Telemetry> telemetry(Count(sizeof(Telemetry)));
+			for (std::size_t i = 0; i < telemetry.size(); ++i)
+			{
+				telemetry[i] = { 1'700'000'000'000 + i * 10, static_cast<std::uint32_t>(i % 64), static_cast<double>(i % 1000) * 0.01, 
+					static_cast<std::uint8_t>(i % 3), static_cast<float>(i % 97), static_cast<float>(i % 89), static_cast<std::int16_t>(20 + i % 5), 
+					230.0 + static_cast<double>(i % 7), static_cast<std::uint8_t>(i & 1) };
+			}
+
+			BenchmarkValue(runner, "vector<telemetry>", size.name, telemetry);
+			BenchmarkColumnar(runner, size.name, telemetry);
+			BenchmarkCompression(runner, "lz<telemetry>", size.name, telemetry);
+			BenchmarkCompression(runner, "lz<columns<telemetry>>", size.name, ColumnarVector(telemetry));
+		}
+
+		{
+			const std::vector<Entity> entities = MakeEntities(Count(40));
+
+			BenchmarkValue(runner, "vector<entity>", size.name, entities);
+			BenchmarkChecksum(runner, "vector<entity>", size.name, entities);
+			BenchmarkDSStream(runner, size.name, entities);
+			BenchmarkDelta(runner, size.name, entities);
+			BenchmarkFrames(runner, size.name, entities);
+			BenchmarkPool(runner, size.name, entities);
+			BenchmarkIncremental(runner, size.name, entities);
+			BenchmarkSnapshot(runner, size.name, entities);
+			BenchmarkCompression(runner, "lz<entity>", size.name, entities);
+		}
+	}
+
+	if (!options.csvPath.empty())
+		runner.WriteCSV(options.csvPath);
+
+	if (!options.jsonPath.empty())
+		runner.WriteJSON(options.jsonPath);
+
+	if (!options.baselinePath.empty() && runner.CompareToBaseline(options.baselinePath) != 0)
+		return 1;
+
+	if (runner.GetNumMismatches() != 0)
+	{
+		std::cerr << runner.GetNumMismatches() << " case(s) decoded data that differs from the input\n";
+		return 1;
+	}
+
 	return 0;
-}
\ No newline at end of file
+}
@@ -13,6 +13,12 @@
 #	ifdef _MSC_VER
 #		pragma warning(disable : 4251) // disable 4251 warning
 #	endif
+#elif defined(__GNUC__) || defined(__clang__)
+#	define DAISER_API_EXPORT __attribute__((visibility("default")))
+#	define DAISER_API_IMPORT __attribute__((visibility("default")))
+#else
+#	define DAISER_API_EXPORT
+#	define DAISER_API_IMPORT
 #endif
 
 #else
@@ -97,6 +103,22 @@
 
 #define DEPREC [[deprecated]] // C14 support is assumed
 
+#ifndef DAISER_COMPACT_ENCODING
+#	define DAISER_COMPACT_ENCODING 0 // varint length prefixes and integers, writer and reader must agree
+#endif
+
+#ifndef DAISER_WIRE_BIG_ENDIAN
+#	define DAISER_WIRE_BIG_ENDIAN 0 // byte order of scalars on the wire, machines that differ swap when reading and writing
+#endif
+
+#ifndef DAISER_UTF8_WSTRING
+#	define DAISER_UTF8_WSTRING 0 // wchar_t strings are transcoded to UTF-8 on the wire rather than written as UTF-16 or UTF-32, writer and reader must agree
+#endif
+
+#ifndef DAISER_PARALLEL_THRESHOLD
+#	define DAISER_PARALLEL_THRESHOLD 0 // element count from which vectors of non-trivial types are chunked and encoded on all cores, 0 disables, writer and reader must agree
+#endif
+
 #ifndef FULL_NAMESPACE
 namespace DaiSer {}
 namespace ds = DaiSer;
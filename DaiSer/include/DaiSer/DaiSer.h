@@ -2,10 +2,25 @@
 
 #include <numeric>
 #include <filesystem>
+#include <concepts>
 
 #include "Serialization/Serializer.h"
+#include "Serialization/FileSerializer.h"
+#include "Serialization/DeserializeArena.h"
+#include "Serialization/IndexedVector.h"
+#include "Serialization/ColumnarVector.h"
+#include "Serialization/PackedVector.h"
+#include "Serialization/Snapshot.h"
+#include "Serialization/Compression.h"
+#include "Serialization/Checksum.h"
+#include "Serialization/MessageBatch.h"
+#include "Serialization/BufferPool.h"
+#include "Serialization/IncrementalReader.h"
+#include "Serialization/StringTable.h"
 #include "Serialization/FieldID.h"
 
+#include "Utility/PerfectHash.hpp"
+
 namespace DaiSer
 {
 	/// For clarity
@@ -15,6 +30,25 @@ namespace DaiSer
 
 	inline constexpr FieldIDType NULL_ID = std::numeric_limits<FieldIDType>::max();
 
+	/// Fixed wire types are only used for arithmetic and enum types, everything else is length-delimited
+	/// 
+	template<typename T>
+	inline constexpr WireType WireTypeOf = []
+	{
+		if constexpr (CompactInteger<T>)
+			return WireType::VarInt;
+		else if constexpr ((std::is_arithmetic_v<T> || std::is_enum_v<T>) && sizeof(T) == 1)
+			return WireType::Fixed8;
+		else if constexpr ((std::is_arithmetic_v<T> || std::is_enum_v<T>) && sizeof(T) == 2)
+			return WireType::Fixed16;
+		else if constexpr ((std::is_arithmetic_v<T> || std::is_enum_v<T>) && sizeof(T) == 4)
+			return WireType::Fixed32;
+		else if constexpr ((std::is_arithmetic_v<T> || std::is_enum_v<T>) && sizeof(T) == 8)
+			return WireType::Fixed64;
+		else
+			return WireType::LengthDelimited;
+	}();
+
 	enum class DSState
 	{
 		Out,
@@ -23,12 +57,51 @@ namespace DaiSer
 
 	class DSStream;
 
+	/// Binds a field ID to a member of the type that is serialized, see FieldSet
+	/// 
+	template<FieldIDType ID, auto Member>
+	struct Field
+	{
+		static constexpr FieldIDType	FIELD_ID	= ID;
+		static constexpr auto			MEMBER		= Member;
+	};
+
+	/// The fields of a message, e.g., FieldSet<Field<1, &Entity::id>, Field<2, &Entity::name>>. Incoming field 
+	/// IDs are looked up in a perfect hash table built at compile time, so reading costs the same no matter 
+	/// in which order the writer declared the fields.
+	/// 
+	template<typename... Fields>
+	struct FieldSet
+	{
+		static constexpr std::size_t NUM_FIELDS = sizeof...(Fields);
+
+		static constexpr PerfectHashTable<NUM_FIELDS> TABLE = PerfectHashTable<NUM_FIELDS>(std::array<std::uint64_t, NUM_FIELDS>{ Fields::FIELD_ID... });
+	};
+
+	/// Each field is written as a varint header, packing the delta from the previous field ID with 
+	/// the wire type, followed by its payload. Fields are expected to be serialized in ascending ID 
+	/// order within a scope, fields that the reader does not ask for are skipped, and fields that are 
+	/// missing from the stream leave the value untouched.
+	/// 
 	class DSScope
 	{
 	public:
 		template<typename T>
 		void Serialize(FieldIDType aID, T& aInOutData);
 
+		/// Delta against a previous state, the field is only written if it differs from the baseline. 
+		/// Since missing fields leave the value untouched, reading applies the written fields as a patch 
+		/// onto an object that already holds the baseline, which the reader does not need to pass.
+		/// 
+		template<std::equality_comparable T>
+		void SerializeDelta(FieldIDType aID, T& aInOutData, const T& aBaseline);
+
+		/// Serializes every member in the field set. Reading consumes the rest of the scope, in whatever order 
+		/// the fields were written, and skips the fields that are not part of the set.
+		/// 
+		template<typename Fields, typename T>
+		void SerializeFields(T& aInOutObject);
+
 	private:
 		DAISER_API DSScope(DSStream& aSerializer);
 
@@ -38,12 +111,24 @@ namespace DaiSer
 		template<typename T>
 		void Read(FieldIDType aID, T& aInData);
 
+		/// Reads the field whose header has been loaded, skips it if its type has changed between schemas
+		/// 
+		template<typename T>
+		void ReadField(T& aOutData);
+
+		template<typename Fields, typename T>
+		void ReadFields(T& aOutObject);
+
+		template<typename T, typename F>
+		static void ReadMember(DSScope& aScope, T& aOutObject);
+
 		DAISER_API void LoadNextID();
 		DAISER_API void SkipField();
 
 		DSStream*	mySerializer	= nullptr;
 		FieldIDType	myPrevID		= NULL_ID;
 		FieldIDType	myNextID		= NULL_ID;
+		WireType	myNextWireType	= WireType::VarInt;
 
 		friend class DSStream;
 	};
@@ -72,9 +157,14 @@ namespace DaiSer
 	public:
 		DAISER_API ODSStream();
 
+		NODISC std::span<const std::byte> GetBuffer() const noexcept { return myWriteSerializer.GetBuffer(); }
+		NODISC ByteBuffer MoveBuffer() { return myWriteSerializer.MoveBuffer(); }
+
 	private:
 		template<typename T>
-		void Serialize(FieldIDType aID, const T& aInData);
+		void Serialize(std::uint64_t aDeltaID, const T& aInData);
+
+		DAISER_API void WriteVarInt(std::uint64_t aValue);
 
 		WriteSerializer myWriteSerializer;
 
@@ -84,12 +174,25 @@ namespace DaiSer
 	class IDSStream : public DSStream
 	{
 	public:
+		DAISER_API IDSStream(ByteBuffer&& aBuffer);
 		DAISER_API IDSStream(std::vector<std::byte>&& aBuffer);
+		DAISER_API IDSStream(MappedFile&& aFile);
+
+		/// Borrows the buffer, the memory must outlive the stream
+		/// 
 		DAISER_API IDSStream(std::span<const std::byte> aBuffer);
 
 	private:
 		template<typename T>
-		void Serialize(FieldIDType aID, T& aOutData);
+		void Serialize(WireType aWireType, T& aOutData);
+
+		/// Returns false if there are no more fields to read
+		/// 
+		DAISER_API bool ReadHeader(std::uint64_t& aOutDeltaID, WireType& aOutWireType);
+
+		DAISER_API void SkipPayload(WireType aWireType);
+
+		NODISC DAISER_API std::uint64_t ReadVarInt();
 
 		ReadSerializer myReadSerializer;
 
@@ -116,15 +219,38 @@ namespace DaiSer
 		}
 	}
 
+	template<std::equality_comparable T>
+	inline void DSScope::SerializeDelta(FieldIDType aID, T& aInOutData, const T& aBaseline)
+	{
+		assert(mySerializer != nullptr && "Serializer must be defined!");
+
+		switch (mySerializer->GetState())
+		{
+			case DSState::Out:
+			{
+				if (!(aInOutData == aBaseline)) // unchanged fields cost nothing, the next ID delta covers the gap
+					Write(aID, aInOutData);
+
+				break;
+			}
+			case DSState::In:
+			{
+				Read(aID, aInOutData);
+				break;
+			}
+		}
+	}
+
 	template<typename T>
 	inline void DSScope::Write(FieldIDType aID, const T& aInData)
 	{
-		std::uint64_t deltaID = (myPrevID == NULL_ID) ? aID : (aID - myPrevID - 1);
+		assert(aID != NULL_ID && "NULL_ID is reserved!");
 
-		// construct field ID from id and delta ID
+		const std::uint64_t deltaID = ZigZagEncode(static_cast<std::int64_t>(aID - (myPrevID + 1))); // NULL_ID + 1 wraps to zero for the first field
+		assert(deltaID < (1ULL << DELTA_ID_BITS) && "Delta between field IDs is too large!");
 
 		ODSStream& out = static_cast<ODSStream&>(*mySerializer);
-		out.Serialize(aID, aInData);
+		out.Serialize(deltaID, aInData);
 
 		myPrevID = aID;
 	}
@@ -132,20 +258,155 @@ namespace DaiSer
 	template<typename T>
 	inline void DSScope::Read(FieldIDType aID, T& aOutData)
 	{
-		IDSStream& in = static_cast<IDSStream&>(*mySerializer);
+		while (myNextID != NULL_ID && myNextID < aID) // fields unknown to this reader
+		{
+			SkipField();
+			LoadNextID();
+		}
+
+		if (myNextID != aID)
+			return; // missing from the stream, keep the current value
 
-		in.Serialize(aID, aOutData);
+		ReadField(aOutData);
+		LoadNextID();
+	}
+
+	template<typename Fields, typename T>
+	inline void DSScope::SerializeFields(T& aInOutObject)
+	{
+		assert(mySerializer != nullptr && "Serializer must be defined!");
+
+		switch (mySerializer->GetState())
+		{
+			case DSState::Out:
+			{
+				[this, &aInOutObject]<typename... Fs>(FieldSet<Fs...>)
+				{
+					(Write(Fs::FIELD_ID, aInOutObject.*Fs::MEMBER), ...);
+				}(Fields{});
+
+				break;
+			}
+			case DSState::In:
+			{
+				ReadFields<Fields>(aInOutObject);
+				break;
+			}
+		}
 	}
 
 	template<typename T>
-	inline void ODSStream::Serialize(FieldIDType aID, const T& aInData)
+	inline void DSScope::ReadField(T& aOutData)
+	{
+		if (myNextWireType == WireTypeOf<T>)
+		{
+			IDSStream& in = static_cast<IDSStream&>(*mySerializer);
+			in.Serialize(myNextWireType, aOutData);
+		}
+		else // type has changed between schemas
+		{
+			SkipField();
+		}
+	}
+
+	template<typename Fields, typename T>
+	inline void DSScope::ReadFields(T& aOutObject)
 	{
+		using Reader = void(*)(DSScope&, T&);
+
+		static constexpr auto readers = []<typename... Fs>(FieldSet<Fs...>)
+		{
+			return std::array<Reader, sizeof...(Fs)>{ &DSScope::ReadMember<T, Fs>... };
+		}(Fields{});
+
+		for (; myNextID != NULL_ID; LoadNextID())
+		{
+			const std::size_t index = Fields::TABLE.Find(myNextID);
+
+			if (index != PerfectHashTable<Fields::NUM_FIELDS>::NOT_FOUND)
+				readers[index](*this, aOutObject);
+			else // unknown to this reader
+				SkipField();
+		}
+	}
 
+	template<typename T, typename F>
+	inline void DSScope::ReadMember(DSScope& aScope, T& aOutObject)
+	{
+		aScope.ReadField(aOutObject.*F::MEMBER);
 	}
 
 	template<typename T>
-	inline void IDSStream::Serialize(FieldIDType aID, T& aOutData)
+	inline void ODSStream::Serialize(std::uint64_t aDeltaID, const T& aInData)
 	{
+		static constexpr WireType wireType = WireTypeOf<T>;
+
+		WriteVarInt(MakeFieldHeader(aDeltaID, wireType));
+
+		ByteBuffer& buffer = myWriteSerializer.myBuffer;
+		std::size_t& offset = myWriteSerializer.myOffset;
+
+		if constexpr (wireType == WireType::LengthDelimited && Measurable<T>)
+		{
+			const std::size_t numBytes		= SerializeImpl<T>{}.Size(aInData);
+			const std::size_t lengthBytes	= VarIntSize(numBytes);
 
+			// single growth check for the whole field, the payload is then written unchecked
+			UncheckedSink sink(buffer.Prepare(offset, lengthBytes + numBytes), lengthBytes + numBytes, offset);
+
+			EncodeVarInt(numBytes, sink.Prepare(offset, lengthBytes));
+			offset += lengthBytes;
+
+			offset += SerializeImpl<T>{}.Write(aInData, sink, offset);
+		}
+		else if constexpr (wireType == WireType::LengthDelimited)
+		{
+			const std::size_t lengthOffset	= offset;
+			const std::size_t payloadOffset	= lengthOffset + 1; // assume that the length fits in a single byte
+
+			(void)buffer.Prepare(lengthOffset, 1); // the payload may write nothing, which would leave the slot unallocated
+
+			const std::size_t numBytes		= SerializeImpl<T>{}.Write(aInData, buffer, payloadOffset);
+			const std::size_t lengthBytes	= VarIntSize(numBytes);
+
+			if (lengthBytes != 1) // rare, make room for the larger length
+			{
+				std::byte* payload = buffer.Prepare(payloadOffset, numBytes + lengthBytes - 1);
+				std::memmove(payload + lengthBytes - 1, payload, numBytes);
+			}
+
+			EncodeVarInt(numBytes, buffer.Prepare(lengthOffset, lengthBytes));
+
+			offset = lengthOffset + lengthBytes + numBytes;
+		}
+		else
+		{
+			offset += SerializeImpl<T>{}.Write(aInData, buffer, offset);
+		}
+	}
+
+	template<typename T>
+	inline void IDSStream::Serialize(WireType aWireType, T& aOutData)
+	{
+		if (aWireType == WireType::LengthDelimited)
+		{
+			const std::size_t numBytes = ReadVarInt();
+
+			std::span<const std::byte> buffer	= myReadSerializer.myBuffer;
+			std::size_t& offset					= myReadSerializer.myOffset;
+
+			assert(offset + numBytes <= buffer.size() && "Not enough memory to read from!");
+
+			// bound the read to the field so that newer writers can append to the payload
+
+			UNSD const std::size_t readBytes = SerializeImpl<T>{}.Read(aOutData, buffer.first(offset + numBytes), offset);
+			assert(readBytes <= numBytes && "Field was read past its length!");
+
+			offset += numBytes;
+		}
+		else
+		{
+			myReadSerializer.Deserialize(aOutData);
+		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,257 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <bit>
+#include <algorithm>
+#include <span>
+
+#include <DaiSer/Config.h>
+#include <DaiSer/Utility/BitUtils.hpp>
+
+#include "Serializer.h"
+#include "OutputSink.h"
+
+/// Bit-level serialization for data where most fields only need a handful of bits. Bits are packed
+/// least significant first into a byte stream, regardless of the byte order of the machine. Anything
+/// that is not a bit field, e.g., strings and arrays, is written byte aligned through SerializeImpl.
+
+namespace DaiSer
+{
+	/// Serialize bit fields to buffer
+	/// 
+	class BitWriteSerializer : protected Serializer
+	{
+	public:
+		DAISER_API BitWriteSerializer();
+
+		/// Writes the lowest aNumBits of the value, aNumBits must be in [0, 64]
+		/// 
+		void SerializeBits(std::uint64_t aValue, std::uint32_t aNumBits);
+
+		void SerializeBool(bool aValue);
+
+		/// Writes the value using only as many bits as the range requires
+		/// 
+		template<RangedValue T>
+		void SerializeRanged(T aValue, T aMin, T aMax);
+
+		/// Pads to the next byte and writes the data as usual
+		/// 
+		template<typename T>
+		void Serialize(const T& aInData);
+
+		/// Pads the remaining bits of the current byte with zeroes
+		/// 
+		DAISER_API void AlignToByte();
+
+		/// Writes out the pending bits and returns everything written so far, more bits can still be
+		/// written afterwards.
+		/// 
+		NODISC DAISER_API std::span<const std::byte> GetBuffer();
+
+		NODISC DAISER_API ByteBuffer MoveBuffer();
+
+		NODISC std::size_t GetNumBits() const noexcept { return myOffset * 8 + myScratchBits; }
+
+		DAISER_API void Clear();
+
+	private:
+		void WriteScratch(std::uint64_t aValue, std::uint32_t aNumBits);
+
+		/// Moves the whole bytes in the scratch to the buffer
+		/// 
+		void FlushScratchBytes();
+
+		ByteBuffer		myBuffer;
+		std::uint64_t	myScratch		= 0;
+		std::uint32_t	myScratchBits	= 0;
+	};
+
+	/// Deserialize bit fields from buffer, the buffer is borrowed and must outlive the serializer
+	/// 
+	class BitReadSerializer : protected Serializer
+	{
+	public:
+		DAISER_API BitReadSerializer(std::span<const std::byte> aBuffer);
+
+		/// Reads aNumBits into the lowest bits of the value, aNumBits must be in [0, 64]
+		/// 
+		void DeserializeBits(std::uint64_t& aOutValue, std::uint32_t aNumBits);
+
+		void DeserializeBool(bool& aOutValue);
+
+		template<RangedValue T>
+		void DeserializeRanged(T& aOutValue, T aMin, T aMax);
+
+		/// Skips to the next byte and reads the data as usual
+		/// 
+		template<typename T>
+		void Deserialize(T& aOutData);
+
+		/// Skips the remaining bits of the current byte
+		/// 
+		DAISER_API void AlignToByte();
+
+		NODISC std::size_t GetRemainingBits() const noexcept { return (myBuffer.size() - myOffset) * 8 + myScratchBits; }
+
+		/// Whether only the padding of the last byte remains
+		/// 
+		NODISC bool IsDone() const noexcept { return GetRemainingBits() < 8; }
+
+	private:
+		std::uint64_t ReadScratch(std::uint32_t aNumBits);
+
+		/// Loads as many whole bytes as fit into the scratch
+		/// 
+		DAISER_API void Refill();
+
+		std::span<const std::byte>	myBuffer;
+		std::uint64_t				myScratch		= 0;
+		std::uint32_t				myScratchBits	= 0;
+	};
+
+	inline void BitWriteSerializer::SerializeBits(std::uint64_t aValue, std::uint32_t aNumBits)
+	{
+		assert(aNumBits <= 64 && "Cannot write more than 64 bits at once!");
+
+		aValue &= LowBitMask(aNumBits);
+
+		if (aNumBits > 32)
+		{
+			WriteScratch(aValue & 0xFFFFFFFF, 32);
+			WriteScratch(aValue >> 32, aNumBits - 32);
+		}
+		else
+		{
+			WriteScratch(aValue, aNumBits);
+		}
+	}
+
+	inline void BitWriteSerializer::SerializeBool(bool aValue)
+	{
+		WriteScratch(aValue ? 1 : 0, 1);
+	}
+
+	template<RangedValue T>
+	inline void BitWriteSerializer::SerializeRanged(T aValue, T aMin, T aMax)
+	{
+		using Unsigned = UnsignedOfT<T>;
+
+		assert(static_cast<Unsigned>(aValue) - static_cast<Unsigned>(aMin) <= static_cast<Unsigned>(aMax) - static_cast<Unsigned>(aMin) && "Value is outside of the range!");
+
+		SerializeBits(static_cast<std::uint64_t>(static_cast<Unsigned>(static_cast<Unsigned>(aValue) - static_cast<Unsigned>(aMin))), BitsRequired(aMin, aMax));
+	}
+
+	template<typename T>
+	inline void BitWriteSerializer::Serialize(const T& aInData)
+	{
+		AlignToByte();
+		FlushScratchBytes();
+
+		myOffset += SerializeImpl<std::decay_t<T>>{}.Write(aInData, myBuffer, myOffset);
+	}
+
+	inline void BitWriteSerializer::WriteScratch(std::uint64_t aValue, std::uint32_t aNumBits)
+	{
+		assert(aNumBits <= 32 && myScratchBits < 32);
+
+		myScratch |= aValue << myScratchBits;
+		myScratchBits += aNumBits;
+
+		if (myScratchBits >= 32)
+		{
+			std::uint32_t word = static_cast<std::uint32_t>(myScratch);
+
+			if constexpr (std::endian::native == std::endian::big)
+				word = ByteSwap(word);
+
+			std::memcpy(myBuffer.Prepare(myOffset, sizeof(word)), &word, sizeof(word));
+
+			myOffset		+= sizeof(word);
+			myScratch		>>= 32;
+			myScratchBits	-= 32;
+		}
+	}
+
+	inline void BitWriteSerializer::FlushScratchBytes()
+	{
+		const std::uint32_t numBytes = myScratchBits / 8;
+
+		if (numBytes == 0)
+			return;
+
+		std::byte* bytes = myBuffer.Prepare(myOffset, numBytes);
+
+		for (std::uint32_t i = 0; i < numBytes; ++i)
+			bytes[i] = static_cast<std::byte>(myScratch >> (i * 8));
+
+		myOffset		+= numBytes;
+		myScratch		= numBytes < 8 ? myScratch >> (numBytes * 8) : 0;
+		myScratchBits	-= numBytes * 8;
+	}
+
+	inline void BitReadSerializer::DeserializeBits(std::uint64_t& aOutValue, std::uint32_t aNumBits)
+	{
+		assert(aNumBits <= 64 && "Cannot read more than 64 bits at once!");
+
+		if (aNumBits > 32)
+		{
+			const std::uint64_t low = ReadScratch(32);
+			aOutValue = low | (ReadScratch(aNumBits - 32) << 32);
+		}
+		else
+		{
+			aOutValue = ReadScratch(aNumBits);
+		}
+	}
+
+	inline void BitReadSerializer::DeserializeBool(bool& aOutValue)
+	{
+		aOutValue = ReadScratch(1) != 0;
+	}
+
+	template<RangedValue T>
+	inline void BitReadSerializer::DeserializeRanged(T& aOutValue, T aMin, T aMax)
+	{
+		using Unsigned = UnsignedOfT<T>;
+
+		std::uint64_t value = 0;
+		DeserializeBits(value, BitsRequired(aMin, aMax));
+
+		aOutValue = static_cast<T>(static_cast<Unsigned>(static_cast<Unsigned>(aMin) + static_cast<Unsigned>(value)));
+	}
+
+	template<typename T>
+	inline void BitReadSerializer::Deserialize(T& aOutData)
+	{
+		AlignToByte();
+
+		// return the whole bytes that were loaded ahead to the buffer
+		myOffset		-= myScratchBits / 8;
+		myScratch		= 0;
+		myScratchBits	= 0;
+
+		myOffset += SerializeImpl<std::decay_t<T>>{}.Read(aOutData, myBuffer, myOffset);
+	}
+
+	inline std::uint64_t BitReadSerializer::ReadScratch(std::uint32_t aNumBits)
+	{
+		assert(aNumBits <= 32);
+
+		if (myScratchBits < aNumBits) [[unlikely]]
+		{
+			Refill();
+			assert(myScratchBits >= aNumBits && "Not enough bits to read from!");
+		}
+
+		const std::uint64_t value = myScratch & LowBitMask(aNumBits);
+
+		myScratch		= aNumBits < 64 ? myScratch >> aNumBits : 0;
+		myScratchBits	-= std::min(aNumBits, myScratchBits);
+
+		return value;
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+
+#include <DaiSer/Config.h>
+
+#include "OutputSink.h"
+
+/// Process-wide pool of byte buffers, so that buffers keep their capacity from one message to the
+/// next instead of being allocated for every WriteSerializer:
+/// 
+///		WriteSerializer writer(BufferPool::Acquire());
+///		writer << response;
+///		Send(writer.GetBuffer());
+///		BufferPool::Release(writer.MoveBuffer());
+/// 
+/// Every thread first goes through a small cache of its own, which needs no synchronization, and
+/// then through a shared lock-free stack that lets buffers released on one thread be acquired on
+/// another.
+
+namespace DaiSer
+{
+	struct BufferPoolStats
+	{
+		std::size_t numAcquired		= 0;
+		std::size_t numHits			= 0;	// acquired buffers that were reused rather than allocated
+		std::size_t numReleased		= 0;
+		std::size_t numDropped		= 0;	// released buffers that were freed since the pool was full or they were too large
+		std::size_t retainedBytes	= 0;	// capacity of the buffers that are currently kept in the pool
+
+		NODISC double GetHitRate() const noexcept { return numAcquired != 0 ? static_cast<double>(numHits) / static_cast<double>(numAcquired) : 0.0; }
+	};
+
+	class BufferPool
+	{
+	public:
+		static constexpr std::size_t LOCAL_CACHE_SIZE		= 8;
+		static constexpr std::size_t SHARED_CACHE_SIZE		= 1024;
+		static constexpr std::size_t MAX_BUFFER_CAPACITY	= 16 * 1024 * 1024; // larger buffers are freed on release rather than kept
+
+		BufferPool() = delete;
+
+		/// Returns an empty buffer with at least the given capacity, reusing a released buffer if there is one
+		/// 
+		NODISC static DAISER_API ByteBuffer Acquire(std::size_t aMinCapacity = 0);
+
+		/// Gives the buffer back to the pool, its contents are discarded but its capacity is kept
+		/// 
+		static DAISER_API void Release(ByteBuffer&& aBuffer);
+
+		/// Counters are gathered from every thread in batches, recent operations may therefore be missing
+		/// 
+		NODISC static DAISER_API BufferPoolStats GetStats() noexcept;
+	};
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <DaiSer/Config.h>
+
+/// CRC32C (Castagnoli) checksums for detecting truncated or corrupted buffers before they are decoded.
+/// The checksum is computed with the SSE4.2 crc32 instruction when the processor supports it, running
+/// three independent streams to hide the latency of the instruction, and with slicing-by-8 tables
+/// otherwise. On x86-64 the instruction is detected at runtime, so builds without /arch or -msse4.2
+/// still use it. Both produce the same value.
+
+namespace DaiSer
+{
+	/// Number of bytes of the trailer written by WriteSerializer::AppendChecksum, a little-endian CRC32C
+	/// 
+	inline constexpr std::size_t CHECKSUM_SIZE = 4;
+
+	/// Continues the checksum of earlier bytes, start with zero for the first bytes
+	/// 
+	NODISC DAISER_API std::uint32_t Crc32c(std::span<const std::byte> aBytes, std::uint32_t aCrc = 0) noexcept;
+}
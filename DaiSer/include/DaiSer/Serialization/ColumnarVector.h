@@ -0,0 +1,311 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <array>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <vector>
+
+#include <DaiSer/Config.h>
+#include <DaiSer/Utility/Reflection.hpp>
+#include <DaiSer/Utility/ByteSwap.hpp>
+
+#include "Serializer.h"
+
+/// Columnar (structure of arrays) encoding of vectors of trivially copyable aggregates. Every member is
+/// written as one contiguous column rather than the rows being copied as they are, which drops the padding
+/// between members, places similar values next to each other so that they compress far better, and lets
+/// readers decode only the columns they need.
+///
+/// Wire format: number of rows, then every column in member declaration order, each being the values of
+/// that member in every row at their full width in the wire byte order. Columns are never varints, even
+/// with DAISER_COMPACT_ENCODING, so that the position of every column follows from the number of rows.
+
+namespace DaiSer
+{
+	/// Trivially copyable aggregates whose members become the columns
+	/// 
+	template<typename T>
+	concept ColumnarRow = std::is_trivially_copyable_v<T> && ReflectableAggregate<T>;
+
+	/// Position of a member within the row, and therefore where the column is gathered from
+	/// 
+	struct ColumnLayout
+	{
+		std::size_t memberOffset	= 0;
+		std::size_t memberSize		= 0;
+	};
+
+	/// Copies the members of the rows into consecutive columns of aNumRows values each. The rows are processed
+	/// in blocks that stay in cache while every column of the block is gathered, so the rows are read only once.
+	/// 
+	DAISER_API void GatherColumns(std::span<const ColumnLayout> aLayouts, const std::byte* aRows, std::size_t aRowSize, std::size_t aNumRows, std::byte* aOutColumns) noexcept;
+
+	/// Copies consecutive columns of aNumRows values each back into the members of the rows
+	/// 
+	DAISER_API void ScatterColumns(std::span<const ColumnLayout> aLayouts, const std::byte* aColumns, std::size_t aNumRows, std::byte* aOutRows, std::size_t aRowSize) noexcept;
+
+	/// Writes the rows as columns, read back with ColumnView<T>
+	/// 
+	template<ColumnarRow T>
+	class ColumnarVector
+	{
+	public:
+		explicit ColumnarVector(std::span<const T> aRows) noexcept : myRows(aRows) {}
+
+		template<typename Alloc>
+		explicit ColumnarVector(const std::vector<T, Alloc>& aRows) noexcept : myRows(aRows) {}
+
+		NODISC std::span<const T> GetRows() const noexcept { return myRows; }
+
+	private:
+		std::span<const T> myRows;
+	};
+
+	template<typename T, typename Alloc>
+	ColumnarVector(const std::vector<T, Alloc>&) -> ColumnarVector<T>;
+
+	/// View of columnar rows that decodes columns on demand. The view borrows the buffer it was read from,
+	/// which must outlive it.
+	/// 
+	template<ColumnarRow T>
+	class ColumnView
+	{
+	public:
+		static constexpr std::size_t NUM_COLUMNS = MemberCount<T>;
+
+		template<std::size_t I>
+		using ColumnType = std::remove_cvref_t<std::tuple_element_t<I, MemberTypes<T>>>;
+
+		ColumnView() = default;
+
+		NODISC std::size_t GetSize() const noexcept { return myNumRows; }
+		NODISC bool IsEmpty() const noexcept { return myNumRows == 0; }
+
+		/// Decodes the values of a single member, the other columns are not touched
+		/// 
+		template<std::size_t I, typename Alloc>
+		void ReadColumn(std::vector<ColumnType<I>, Alloc>& aOutValues) const;
+
+		template<std::size_t I>
+		NODISC std::vector<ColumnType<I>> ReadColumn() const;
+
+		/// Reassembles every row into aOutRows, which allows reusing its memory
+		/// 
+		template<typename Alloc>
+		void ToVector(std::vector<T, Alloc>& aOutRows) const;
+
+		NODISC std::vector<T> ToVector() const;
+
+	private:
+		template<std::size_t I>
+		NODISC std::size_t GetColumnOffset() const noexcept;
+
+		std::span<const std::byte>	myBuffer;
+		std::size_t					myNumRows		= 0;
+		std::size_t					myColumnsOffset	= 0;
+
+		friend struct SerializeImpl<ColumnView<T>>;
+	};
+
+	template<ColumnarRow T>
+	struct SerializeImpl<ColumnarVector<T>>
+	{
+		NODISC std::size_t Size(const ColumnarVector<T>& aInData) const;
+
+		template<ByteSink Sink>
+		NODISC std::size_t Write(const ColumnarVector<T>& aInData, Sink& aOutSink, std::size_t aOffset);
+	};
+
+	template<ColumnarRow T>
+	struct SerializeImpl<ColumnView<T>>
+	{
+		/// Only reads the number of rows, the columns are skipped and decoded by the view when requested
+		/// 
+		NODISC std::size_t Read(ColumnView<T>& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset);
+	};
+
+	/// Returns the position of every member within the row, found from the addresses of the members of a row
+	/// since offsetof cannot be used through structured bindings
+	/// 
+	template<ColumnarRow T>
+	NODISC inline std::array<ColumnLayout, MemberCount<T>> GetColumnLayouts(const T& aRow) noexcept
+	{
+		return std::apply([&aRow](const auto&... aMembers)
+		{
+			const std::byte* row = reinterpret_cast<const std::byte*>(std::addressof(aRow));
+
+			return std::array<ColumnLayout, sizeof...(aMembers)>
+			{
+				ColumnLayout{ static_cast<std::size_t>(reinterpret_cast<const std::byte*>(std::addressof(aMembers)) - row), sizeof(aMembers) }...
+			};
+		}, TieMembers(aRow));
+	}
+
+	/// Number of bytes of a single row over all columns, which is the row without its padding
+	/// 
+	template<ColumnarRow T>
+	inline constexpr std::size_t COLUMNAR_ROW_SIZE = []<std::size_t... Is>(std::index_sequence<Is...>)
+	{
+		return (sizeof(std::tuple_element_t<Is, MemberTypes<T>>) + ... + 0);
+	}(std::make_index_sequence<MemberCount<T>>{});
+
+	/// Converts every column between the native and the wire byte order in place
+	/// 
+	template<ColumnarRow T>
+	inline void SwapColumns(std::byte* aColumns, std::size_t aNumRows) noexcept
+	{
+		[&]<std::size_t... Is>(std::index_sequence<Is...>)
+		{
+			std::size_t offset = 0;
+
+			((SwapBytesElements<std::remove_cvref_t<std::tuple_element_t<Is, MemberTypes<T>>>>(aColumns + offset, aColumns + offset, aNumRows),
+				offset += sizeof(std::tuple_element_t<Is, MemberTypes<T>>) * aNumRows), ...);
+		}(std::make_index_sequence<MemberCount<T>>{});
+	}
+
+	template<ColumnarRow T>
+	inline std::size_t SerializeImpl<ColumnarVector<T>>::Size(const ColumnarVector<T>& aInData) const
+	{
+		return LengthSize(aInData.GetRows().size()) + COLUMNAR_ROW_SIZE<T> * aInData.GetRows().size();
+	}
+
+	template<ColumnarRow T>
+	template<ByteSink Sink>
+	inline std::size_t SerializeImpl<ColumnarVector<T>>::Write(const ColumnarVector<T>& aInData, Sink& aOutSink, std::size_t aOffset)
+	{
+		const std::span<const T> rows = aInData.GetRows();
+
+		const std::size_t numBytes		= WriteLength(rows.size(), aOutSink, aOffset);
+		const std::size_t columnBytes	= COLUMNAR_ROW_SIZE<T> * rows.size();
+
+		if (rows.empty())
+			return numBytes;
+
+		const std::array<ColumnLayout, MemberCount<T>> layouts = GetColumnLayouts(rows.front());
+
+		const std::byte* rowBytes = reinterpret_cast<const std::byte*>(rows.data());
+
+		if constexpr (WindowedSink<Sink>)
+		{
+			// the sink only holds a window, so every column is gathered in pieces that fit it
+			std::size_t offset = aOffset + numBytes;
+
+			[&]<std::size_t... Is>(std::index_sequence<Is...>)
+			{
+				([&]()
+				{
+					using Column = std::remove_cvref_t<std::tuple_element_t<Is, MemberTypes<T>>>;
+
+					const std::size_t pieceRows = std::max<std::size_t>(1, MaxPrepareSize(aOutSink) / sizeof(Column));
+
+					for (std::size_t first = 0; first < rows.size(); first += pieceRows)
+					{
+						const std::size_t numRows = std::min(pieceRows, rows.size() - first);
+
+						std::byte* piece = aOutSink.Prepare(offset, numRows * sizeof(Column));
+						GatherColumns(std::span(&layouts[Is], 1), rowBytes + first * sizeof(T), sizeof(T), numRows, piece);
+
+						if constexpr (WIRE_ENDIAN != std::endian::native)
+							SwapBytesElements<Column>(piece, piece, numRows);
+
+						offset += numRows * sizeof(Column);
+					}
+				}(), ...);
+			}(std::make_index_sequence<MemberCount<T>>{});
+		}
+		else
+		{
+			std::byte* columns = aOutSink.Prepare(aOffset + numBytes, columnBytes);
+			GatherColumns(layouts, rowBytes, sizeof(T), rows.size(), columns);
+
+			if constexpr (WIRE_ENDIAN != std::endian::native)
+				SwapColumns<T>(columns, rows.size());
+		}
+
+		return numBytes + columnBytes;
+	}
+
+	template<ColumnarRow T>
+	inline std::size_t SerializeImpl<ColumnView<T>>::Read(ColumnView<T>& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset)
+	{
+		std::size_t numRows = 0;
+		const std::size_t numBytes = ReadLength(numRows, aInBytes, aOffset);
+
+		assert(numRows <= (aInBytes.size() - aOffset - numBytes) / COLUMNAR_ROW_SIZE<T> && "Not enough memory to read from!");
+
+		aOutData.myBuffer			= aInBytes;
+		aOutData.myNumRows			= numRows;
+		aOutData.myColumnsOffset	= aOffset + numBytes;
+
+		return numBytes + COLUMNAR_ROW_SIZE<T> * numRows;
+	}
+
+	template<ColumnarRow T>
+	template<std::size_t I>
+	inline std::size_t ColumnView<T>::GetColumnOffset() const noexcept
+	{
+		return myColumnsOffset + myNumRows * []<std::size_t... Is>(std::index_sequence<Is...>)
+		{
+			return (sizeof(ColumnType<Is>) + ... + 0);
+		}(std::make_index_sequence<I>{});
+	}
+
+	template<ColumnarRow T>
+	template<std::size_t I, typename Alloc>
+	inline void ColumnView<T>::ReadColumn(std::vector<ColumnType<I>, Alloc>& aOutValues) const
+	{
+		static_assert(I < NUM_COLUMNS, "Column index is out of range");
+
+		aOutValues.resize(myNumRows);
+
+		if (myNumRows == 0)
+			return;
+
+		if constexpr (WIRE_ENDIAN != std::endian::native)
+			SwapBytesElements<ColumnType<I>>(reinterpret_cast<std::byte*>(aOutValues.data()), myBuffer.data() + GetColumnOffset<I>(), myNumRows);
+		else
+			std::memcpy(aOutValues.data(), myBuffer.data() + GetColumnOffset<I>(), myNumRows * sizeof(ColumnType<I>));
+	}
+
+	template<ColumnarRow T>
+	template<std::size_t I>
+	inline std::vector<typename ColumnView<T>::template ColumnType<I>> ColumnView<T>::ReadColumn() const
+	{
+		std::vector<ColumnType<I>> result;
+		ReadColumn<I>(result);
+
+		return result;
+	}
+
+	template<ColumnarRow T>
+	template<typename Alloc>
+	inline void ColumnView<T>::ToVector(std::vector<T, Alloc>& aOutRows) const
+	{
+		aOutRows.resize(myNumRows);
+
+		if (myNumRows == 0)
+			return;
+
+		const std::array<ColumnLayout, MemberCount<T>> layouts = GetColumnLayouts(aOutRows.front());
+		ScatterColumns(layouts, myBuffer.data() + myColumnsOffset, myNumRows, reinterpret_cast<std::byte*>(aOutRows.data()), sizeof(T));
+
+		if constexpr (WIRE_ENDIAN != std::endian::native)
+		{
+			for (T& row : aOutRows)
+				SwapBytesInPlace(row);
+		}
+	}
+
+	template<ColumnarRow T>
+	inline std::vector<T> ColumnView<T>::ToVector() const
+	{
+		std::vector<T> result;
+		ToVector(result);
+
+		return result;
+	}
+}
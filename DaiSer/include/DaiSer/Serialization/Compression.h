@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+#include <DaiSer/Config.h>
+
+#include "OutputSink.h"
+
+/// Fast LZ77 block compression for serialized buffers, meant to sit between WriteSerializer and its
+/// destination, and between the source and ReadSerializer:
+/// 
+///		ByteBuffer compressed = Compress(writer.GetBuffer());
+///		ReadSerializer reader(Decompress(compressed));
+/// 
+/// The input is split into blocks that are compressed independently, so large buffers can be handled
+/// one block at a time with CompressBlock and DecompressBlock. Blocks whose bytes look random, or that
+/// do not get any smaller, are stored as-is and cost only a copy to decompress.
+/// 
+/// Every block starts with two little-endian 32-bit words, the number of stored bytes (the highest bit
+/// is set if the bytes are stored uncompressed) and the number of bytes after decompression.
+
+namespace DaiSer
+{
+	inline constexpr std::size_t DEFAULT_COMPRESSION_BLOCK_SIZE	= 1 << 17;
+	inline constexpr std::size_t MAX_COMPRESSION_BLOCK_SIZE		= 1 << 30;
+	inline constexpr std::size_t COMPRESSION_BLOCK_HEADER_SIZE	= 8;
+
+	/// Largest number of bytes that compressing aNumBytes can produce
+	/// 
+	NODISC DAISER_API std::size_t CompressBound(std::size_t aNumBytes, std::size_t aBlockSize = DEFAULT_COMPRESSION_BLOCK_SIZE);
+
+	/// Compresses the input as a single block and writes it at aOffset, returns the number of bytes written
+	/// 
+	DAISER_API std::size_t CompressBlock(std::span<const std::byte> aInput, ByteBuffer& aOutBuffer, std::size_t aOffset);
+
+	/// Decompresses the block at the start of the input and writes it at aInOutOffset, which is advanced by
+	/// the number of decompressed bytes. Returns the number of bytes consumed from the input, throws
+	/// std::runtime_error if the block is corrupt.
+	/// 
+	DAISER_API std::size_t DecompressBlock(std::span<const std::byte> aInput, ByteBuffer& aOutBuffer, std::size_t& aInOutOffset);
+
+	NODISC DAISER_API ByteBuffer Compress(std::span<const std::byte> aInput, std::size_t aBlockSize = DEFAULT_COMPRESSION_BLOCK_SIZE);
+
+	/// Throws std::runtime_error if the input is corrupt
+	/// 
+	NODISC DAISER_API ByteBuffer Decompress(std::span<const std::byte> aInput);
+}
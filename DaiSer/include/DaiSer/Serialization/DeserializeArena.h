@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <algorithm>
+#include <memory_resource>
+
+#include <DaiSer/Config.h>
+
+namespace DaiSer
+{
+	/// Monotonic arena to deserialize a whole message into. Allocations are a pointer bump, individual 
+	/// deallocations are ignored, and all memory is given back at once when the arena is released or 
+	/// destroyed, regardless of how many objects were decoded into it.
+	/// 
+	class DeserializeArena
+	{
+	public:
+		/// Decoded containers usually take more memory than their encoded bytes, the initial block is 
+		/// therefore a multiple of the buffer size to avoid going back to the upstream resource.
+		/// 
+		static constexpr std::size_t BUFFER_SIZE_FACTOR = 2;
+
+		explicit DeserializeArena(std::size_t aInitialSize, std::pmr::memory_resource* aUpstream = std::pmr::get_default_resource())
+			: myResource(std::max<std::size_t>(aInitialSize, 1), aUpstream) {}
+
+		explicit DeserializeArena(std::span<const std::byte> aBuffer, std::pmr::memory_resource* aUpstream = std::pmr::get_default_resource())
+			: DeserializeArena(aBuffer.size() * BUFFER_SIZE_FACTOR, aUpstream) {}
+
+		DeserializeArena(const DeserializeArena&) = delete;
+		DeserializeArena& operator=(const DeserializeArena&) = delete;
+
+		NODISC std::pmr::memory_resource* GetResource() noexcept { return &myResource; }
+
+		/// Frees everything allocated from the arena, objects that still use it must not be touched afterwards
+		/// 
+		void Release() { myResource.release(); }
+
+	private:
+		std::pmr::monotonic_buffer_resource myResource;
+	};
+}
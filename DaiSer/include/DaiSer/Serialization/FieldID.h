@@ -2,6 +2,8 @@
 
 #include <cstdint>
 
+#include <DaiSer/Utility/BitUtils.hpp>
+
 namespace DaiSer
 {
 	using FieldIDType = std::uint64_t;
@@ -19,4 +21,37 @@ namespace DaiSer
 	private:
 		FieldIDType myID = 0;
 	};
-}
\ No newline at end of file
+
+	/// Describes how the payload of a field is stored, allowing readers to skip fields they do not know
+	/// 
+	enum class WireType : std::uint8_t
+	{
+		VarInt,				// LEB128 encoded integer
+		Fixed8,
+		Fixed16,
+		Fixed32,
+		Fixed64,
+		LengthDelimited,	// varint length followed by the payload
+	};
+
+	inline constexpr std::uint64_t DELTA_ID_BITS	= 61;
+	inline constexpr std::uint64_t WIRE_TYPE_BITS	= 3;
+
+	/// Packs the zigzagged delta from the previous field ID together with the wire type, the result
+	/// is written as a varint and therefore stays a single byte for consecutive IDs.
+	/// 
+	constexpr std::uint64_t MakeFieldHeader(std::uint64_t aDeltaID, WireType aWireType)
+	{
+		return PackValues64<DELTA_ID_BITS, WIRE_TYPE_BITS>({ aDeltaID, static_cast<std::uint64_t>(aWireType) });
+	}
+
+	constexpr std::uint64_t GetHeaderDeltaID(std::uint64_t aHeader)
+	{
+		return ExtractValue64<DELTA_ID_BITS, 0>(aHeader);
+	}
+
+	constexpr WireType GetHeaderWireType(std::uint64_t aHeader)
+	{
+		return static_cast<WireType>(ExtractValue64<WIRE_TYPE_BITS, DELTA_ID_BITS>(aHeader));
+	}
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+
+#include <DaiSer/Config.h>
+
+#include "Serializer.h"
+#include "OutputSink.h"
+
+namespace DaiSer
+{
+	/// Writes to a file through a fixed-size chunk, bytes before the offset being written are flushed
+	/// to the file whenever the chunk runs out of room. Offsets given to Prepare must therefore never
+	/// decrease, which holds for all SerializeImpl::Write since they write front to back. Contiguous
+	/// payloads larger than the chunk are given to Write and go straight to the file, and encoded 
+	/// payloads are prepared in pieces of at most the chunk size. Only a single value that is encoded
+	/// at once and is larger than the chunk, e.g., a chunk of a parallel vector, grows it to fit.
+	/// 
+	class FileSink
+	{
+	public:
+		static constexpr std::size_t DEFAULT_CHUNK_SIZE = 1 << 20;
+
+		/// Creates or truncates the file, throws std::runtime_error if it could not be opened
+		/// 
+		DAISER_API explicit FileSink(const std::filesystem::path& aPath, std::size_t aChunkSize = DEFAULT_CHUNK_SIZE);
+
+		/// Flushes any remaining bytes, errors are ignored, call Close to have them reported
+		/// 
+		DAISER_API ~FileSink();
+
+		FileSink(const FileSink&) = delete;
+		FileSink& operator=(const FileSink&) = delete;
+
+		/// Total number of bytes written, including those that are still in the chunk
+		/// 
+		NODISC std::size_t GetSize() const noexcept { return myChunkOffset + myChunk.GetSize(); }
+
+		NODISC std::byte* Prepare(std::size_t aOffset, std::size_t aNumBytes);
+
+		/// Copies the bytes, bytes that do not fit the chunk are written to the file without being copied
+		/// 
+		DAISER_API void Write(std::size_t aOffset, const std::byte* aData, std::size_t aNumBytes);
+
+		NODISC std::size_t GetWindowSize() const noexcept { return myChunkSize; }
+
+		/// Writes everything in the chunk to the file, throws std::runtime_error on failure
+		/// 
+		DAISER_API void Flush();
+
+		/// Flushes and closes the file, throws std::runtime_error on failure
+		/// 
+		DAISER_API void Close();
+
+	private:
+		DAISER_API void Spill(std::size_t aOffset);
+
+		DAISER_API void WriteToFile(const std::byte* aData, std::size_t aNumBytes);
+
+		std::FILE*	myFile			= nullptr;
+		ByteBuffer	myChunk;
+		std::size_t	myChunkOffset	= 0; // offset in the file of the first byte in the chunk
+		std::size_t	myChunkSize		= 0;
+	};
+
+	/// Serializes variables straight to a file, peak memory is bounded by the chunk size rather
+	/// than the size of the file, see FileSink for the exceptions.
+	/// 
+	class FileWriteSerializer : protected Serializer
+	{
+	public:
+		DAISER_API explicit FileWriteSerializer(const std::filesystem::path& aPath, std::size_t aChunkSize = FileSink::DEFAULT_CHUNK_SIZE);
+
+		template<typename T>
+		void Serialize(const T& aInData);
+
+		DAISER_API void Flush();
+
+		DAISER_API void Close();
+
+	private:
+		FileSink mySink;
+	};
+
+	inline std::byte* FileSink::Prepare(std::size_t aOffset, std::size_t aNumBytes)
+	{
+		assert(aOffset >= myChunkOffset && "Cannot write to bytes that have already been flushed!");
+
+		if (aOffset + aNumBytes - myChunkOffset > myChunk.GetCapacity()) [[unlikely]]
+			Spill(aOffset);
+
+		return myChunk.Prepare(aOffset - myChunkOffset, aNumBytes);
+	}
+
+	template<typename T>
+	inline void FileWriteSerializer::Serialize(const T& aInData)
+	{
+		myOffset += SerializeImpl<std::decay_t<T>>{}.Write(aInData, mySink, myOffset);
+	}
+
+	template<typename T>
+	inline FileWriteSerializer& operator<<(FileWriteSerializer& aFileWriteSerializer, const T& aInData)
+	{
+		aFileWriteSerializer.Serialize(aInData);
+		return aFileWriteSerializer;
+	}
+}
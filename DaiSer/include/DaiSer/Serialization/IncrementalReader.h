@@ -0,0 +1,479 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <tuple>
+
+#include <DaiSer/Config.h>
+
+#include "Serializer.h"
+#include "OutputSink.h"
+
+/// Decoding of a message while its bytes are still arriving. The values to read are listed in a
+/// coroutine, which is suspended whenever the bytes received so far end in the middle of a value
+/// and resumed by Feed once they no longer do:
+/// 
+///		IncrementalReader reader;
+/// 
+///		DecodeTask task = [](IncrementalReader& aReader, Header& aHeader, std::vector<Entity>& aEntities) -> DecodeTask
+///		{
+///			co_await aReader.Read(aHeader);
+///			co_await aReader.Read(aEntities);
+///		}(reader, header, entities);
+/// 
+///		while (!task.IsDone())
+///			reader.Feed(Receive());
+/// 
+/// Vectors are decoded element by element as their bytes arrive, other values once all of their
+/// bytes have arrived. Whether that is the case is determined by ScanEncodedSize, which walks the
+/// encoded bytes without decoding them.
+
+namespace DaiSer
+{
+	/// Returns the number of bytes the value at the offset is encoded as, or nothing if the bytes end before the value does
+	/// 
+	template<typename T>
+	NODISC std::optional<std::size_t> ScanEncodedSize(std::span<const std::byte> aInBytes, std::size_t aOffset);
+
+	template<typename T>
+	struct ScanImpl
+	{
+		NODISC std::optional<std::size_t> Scan(std::span<const std::byte> aInBytes, std::size_t aOffset) const;
+	};
+
+	template<typename CharT, typename Traits, typename Alloc>
+	struct ScanImpl<std::basic_string<CharT, Traits, Alloc>>
+	{
+		NODISC std::optional<std::size_t> Scan(std::span<const std::byte> aInBytes, std::size_t aOffset) const;
+	};
+
+	template<>
+	struct ScanImpl<std::string_view> : ScanImpl<std::string> {};
+
+	template<typename T, typename Alloc>
+	struct ScanImpl<std::vector<T, Alloc>>
+	{
+		NODISC std::optional<std::size_t> Scan(std::span<const std::byte> aInBytes, std::size_t aOffset) const;
+	};
+
+	template<typename T>
+	struct ScanImpl<std::span<const T>> : ScanImpl<std::vector<T>> {};
+
+	template<typename Map>
+	struct ScanMapImpl
+	{
+		NODISC std::optional<std::size_t> Scan(std::span<const std::byte> aInBytes, std::size_t aOffset) const;
+	};
+
+	template<typename Key, typename Value, typename Compare, typename Alloc>
+	struct ScanImpl<std::map<Key, Value, Compare, Alloc>> : ScanMapImpl<std::map<Key, Value, Compare, Alloc>> {};
+
+	template<typename Key, typename Value, typename Hash, typename Equal, typename Alloc>
+	struct ScanImpl<std::unordered_map<Key, Value, Hash, Equal, Alloc>> : ScanMapImpl<std::unordered_map<Key, Value, Hash, Equal, Alloc>> {};
+
+	template<typename T, typename U> requires (!std::is_trivially_copyable_v<std::pair<T, U>>)
+	struct ScanImpl<std::pair<T, U>>
+	{
+		NODISC std::optional<std::size_t> Scan(std::span<const std::byte> aInBytes, std::size_t aOffset) const;
+	};
+
+	template<typename... Ts> requires (!std::is_trivially_copyable_v<std::tuple<Ts...>>)
+	struct ScanImpl<std::tuple<Ts...>>
+	{
+		NODISC std::optional<std::size_t> Scan(std::span<const std::byte> aInBytes, std::size_t aOffset) const;
+	};
+
+	/// Scans the values one after the other, returns their total size
+	/// 
+	template<typename... Ts>
+	NODISC std::optional<std::size_t> ScanSequence(std::span<const std::byte> aInBytes, std::size_t aOffset);
+
+	/// Scans the length prefix of a container, returns its size
+	/// 
+	NODISC std::optional<std::size_t> ScanLength(std::size_t& aOutLength, std::span<const std::byte> aInBytes, std::size_t aOffset);
+
+	/// Coroutine that lists the values to decode from an IncrementalReader, it runs until the first value
+	/// whose bytes have not arrived yet as soon as it is created
+	/// 
+	class DecodeTask
+	{
+	public:
+		struct promise_type
+		{
+			DecodeTask get_return_object() noexcept { return DecodeTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+
+			std::suspend_never initial_suspend() const noexcept { return {}; }
+			std::suspend_always final_suspend() const noexcept { return {}; }
+
+			void return_void() const noexcept {}
+			void unhandled_exception() noexcept { exception = std::current_exception(); }
+
+			std::exception_ptr exception;
+		};
+
+		DecodeTask(const DecodeTask&) = delete;
+		DecodeTask& operator=(const DecodeTask&) = delete;
+
+		DAISER_API DecodeTask(DecodeTask&& aOther) noexcept;
+		DAISER_API DecodeTask& operator=(DecodeTask&& aOther) noexcept;
+
+		/// The reader must not be fed after the task has been destroyed
+		/// 
+		DAISER_API ~DecodeTask();
+
+		/// Whether every value has been decoded, rethrows any exception thrown while decoding
+		/// 
+		NODISC DAISER_API bool IsDone() const;
+
+	private:
+		explicit DecodeTask(std::coroutine_handle<promise_type> aHandle) noexcept
+			: myHandle(aHandle) {}
+
+		std::coroutine_handle<promise_type> myHandle;
+	};
+
+	/// Keeps the received bytes that have not been decoded yet, values read as views (std::string_view,
+	/// std::span) point into memory that is reused and are therefore not supported.
+	/// 
+	class IncrementalReader
+	{
+	public:
+		IncrementalReader() = default;
+
+		IncrementalReader(const IncrementalReader&) = delete;
+		IncrementalReader& operator=(const IncrementalReader&) = delete;
+
+		/// Appends the bytes and resumes the waiting task once the value it waits for can be finished
+		/// 
+		DAISER_API void Feed(std::span<const std::byte> aBytes);
+
+		/// Decodes the value, suspending the task until enough bytes have been fed
+		/// 
+		template<typename T>
+		NODISC auto Read(T& aOutData);
+
+		/// Bytes that have been fed but not decoded yet
+		/// 
+		NODISC std::size_t GetBufferedBytes() const noexcept { return myBuffer.GetSize() - myOffset; }
+
+		NODISC bool IsWaiting() const noexcept { return static_cast<bool>(myWaiter); }
+
+	private:
+		static constexpr std::size_t NO_ELEMENTS = SIZE_MAX;
+
+		template<typename T>
+		struct ReadAwaiter
+		{
+			bool await_ready() { return reader.Progress(data); }
+			void await_suspend(std::coroutine_handle<> aHandle) noexcept;
+			void await_resume() const noexcept {}
+
+			IncrementalReader&	reader;
+			T&					data;
+		};
+
+		/// Decodes as much of the value as the bytes allow, returns true once the value is complete
+		/// 
+		template<typename T>
+		bool Progress(T& aOutData);
+
+		template<typename T, typename Alloc>
+		bool Progress(std::vector<T, Alloc>& aOutData);
+
+		ByteBuffer	myBuffer;
+		std::size_t	myOffset		= 0;
+		std::size_t	myNumElements	= NO_ELEMENTS;	// of the vector being decoded
+		std::size_t	myNextElement	= 0;
+
+		std::coroutine_handle<>	myWaiter;
+		void*					myPendingData		= nullptr;
+		bool					(*myPendingProgress)(IncrementalReader&, void*) = nullptr;
+	};
+
+	template<typename T>
+	inline std::optional<std::size_t> ScanEncodedSize(std::span<const std::byte> aInBytes, std::size_t aOffset)
+	{
+		return ScanImpl<T>{}.Scan(aInBytes, aOffset);
+	}
+
+	inline std::optional<std::size_t> ScanLength(std::size_t& aOutLength, std::span<const std::byte> aInBytes, std::size_t aOffset)
+	{
+		if constexpr (CompactInteger<std::uint64_t>)
+		{
+			std::uint64_t length = 0;
+			const std::size_t numBytes = DecodeVarInt(aInBytes.data() + aOffset, aInBytes.size() - aOffset, length);
+
+			if (numBytes == 0)
+				return std::nullopt;
+
+			aOutLength = static_cast<std::size_t>(length);
+
+			return numBytes;
+		}
+		else
+		{
+			if (aInBytes.size() - aOffset < sizeof(std::uint64_t))
+				return std::nullopt;
+
+			return ReadLength(aOutLength, aInBytes, aOffset);
+		}
+	}
+
+	template<typename... Ts>
+	inline std::optional<std::size_t> ScanSequence(std::span<const std::byte> aInBytes, std::size_t aOffset)
+	{
+		std::size_t numBytes = 0;
+
+		const auto ScanNext = [&]<typename U>(std::type_identity<U>)
+		{
+			const std::optional<std::size_t> size = ScanEncodedSize<U>(aInBytes, aOffset + numBytes);
+
+			if (size)
+				numBytes += *size;
+
+			return size.has_value();
+		};
+
+		if (!(ScanNext(std::type_identity<Ts>{}) && ...))
+			return std::nullopt;
+
+		return numBytes;
+	}
+
+	template<typename T>
+	inline std::optional<std::size_t> ScanImpl<T>::Scan(std::span<const std::byte> aInBytes, std::size_t aOffset) const
+	{
+		if constexpr (FixedSizeOf<T> != 0 || WireSwapped<T>)
+		{
+			constexpr std::size_t size = WireSwapped<T> ? sizeof(T) : FixedSizeOf<T>;
+
+			if (aInBytes.size() - aOffset < size)
+				return std::nullopt;
+
+			return size;
+		}
+		else if constexpr (CompactInteger<T>)
+		{
+			std::uint64_t value = 0;
+			const std::size_t numBytes = DecodeVarInt(aInBytes.data() + aOffset, aInBytes.size() - aOffset, value);
+
+			if (numBytes == 0)
+				return std::nullopt;
+
+			return numBytes;
+		}
+		else if constexpr (!std::is_trivially_copyable_v<T> && ReflectableAggregate<T>)
+		{
+			return []<std::size_t... Is>(std::span<const std::byte> aBytes, std::size_t aAt, std::index_sequence<Is...>)
+			{
+				return ScanSequence<std::remove_cvref_t<std::tuple_element_t<Is, MemberTypes<T>>>...>(aBytes, aAt);
+			}(aInBytes, aOffset, std::make_index_sequence<std::tuple_size_v<MemberTypes<T>>>{});
+		}
+		else
+		{
+			static_assert(!sizeof(T), "The encoded size of the type is unknown, provide a ScanImpl for it");
+		}
+	}
+
+	template<typename CharT, typename Traits, typename Alloc>
+	inline std::optional<std::size_t> ScanImpl<std::basic_string<CharT, Traits, Alloc>>::Scan(std::span<const std::byte> aInBytes, std::size_t aOffset) const
+	{
+		static constexpr std::size_t WIRE_CHAR_SIZE = IS_UTF8_ON_WIRE<CharT> ? 1 : sizeof(CharT);
+
+		std::uint64_t length = 0;
+		const std::size_t prefixBytes = DecodeVarInt(aInBytes.data() + aOffset, aInBytes.size() - aOffset, length);
+
+		if (prefixBytes == 0 || (aInBytes.size() - aOffset - prefixBytes) / WIRE_CHAR_SIZE < length)
+			return std::nullopt;
+
+		return prefixBytes + static_cast<std::size_t>(length) * WIRE_CHAR_SIZE;
+	}
+
+	template<typename T, typename Alloc>
+	inline std::optional<std::size_t> ScanImpl<std::vector<T, Alloc>>::Scan(std::span<const std::byte> aInBytes, std::size_t aOffset) const
+	{
+		std::size_t numElements = 0;
+		const std::optional<std::size_t> prefixBytes = ScanLength(numElements, aInBytes, aOffset);
+
+		if (!prefixBytes)
+			return std::nullopt;
+
+		std::size_t numBytes = *prefixBytes;
+
+		if constexpr (std::is_trivially_copyable_v<T> && !CompactInteger<T>)
+		{
+			if ((aInBytes.size() - aOffset - numBytes) / sizeof(T) < numElements) // avoids overflowing on corrupt lengths
+				return std::nullopt;
+
+			return numBytes + sizeof(T) * numElements;
+		}
+		else
+		{
+			std::size_t numItems = numElements;
+
+			if (IsChunkedLayout<T>(numElements)) // the chunk sizes are scanned instead, followed by the chunks as a whole
+				numItems = (numElements + PARALLEL_CHUNK_SIZE - 1) / PARALLEL_CHUNK_SIZE;
+
+			std::size_t numChunkBytes = 0;
+
+			for (std::size_t i = 0; i < numItems; ++i)
+			{
+				std::optional<std::size_t> itemBytes;
+
+				if (IsChunkedLayout<T>(numElements))
+				{
+					std::size_t chunkBytes = 0;
+					itemBytes = ScanLength(chunkBytes, aInBytes, aOffset + numBytes);
+
+					numChunkBytes += chunkBytes;
+				}
+				else
+				{
+					itemBytes = ScanEncodedSize<T>(aInBytes, aOffset + numBytes);
+				}
+
+				if (!itemBytes)
+					return std::nullopt;
+
+				numBytes += *itemBytes;
+			}
+
+			if (aInBytes.size() - aOffset - numBytes < numChunkBytes)
+				return std::nullopt;
+
+			return numBytes + numChunkBytes;
+		}
+	}
+
+	template<typename Map>
+	inline std::optional<std::size_t> ScanMapImpl<Map>::Scan(std::span<const std::byte> aInBytes, std::size_t aOffset) const
+	{
+		std::size_t numEntries = 0;
+		std::optional<std::size_t> numBytes = ScanLength(numEntries, aInBytes, aOffset);
+
+		for (std::size_t i = 0; i < numEntries && numBytes; ++i)
+		{
+			const std::optional<std::size_t> entryBytes = ScanSequence<typename Map::key_type, typename Map::mapped_type>(aInBytes, aOffset + *numBytes);
+			numBytes = entryBytes ? std::optional(*numBytes + *entryBytes) : std::nullopt;
+		}
+
+		return numBytes;
+	}
+
+	template<typename T, typename U> requires (!std::is_trivially_copyable_v<std::pair<T, U>>)
+	inline std::optional<std::size_t> ScanImpl<std::pair<T, U>>::Scan(std::span<const std::byte> aInBytes, std::size_t aOffset) const
+	{
+		return ScanSequence<T, U>(aInBytes, aOffset);
+	}
+
+	template<typename... Ts> requires (!std::is_trivially_copyable_v<std::tuple<Ts...>>)
+	inline std::optional<std::size_t> ScanImpl<std::tuple<Ts...>>::Scan(std::span<const std::byte> aInBytes, std::size_t aOffset) const
+	{
+		return ScanSequence<Ts...>(aInBytes, aOffset);
+	}
+
+	template<typename T>
+	inline auto IncrementalReader::Read(T& aOutData)
+	{
+		assert(!myWaiter && "Only a single task can read at a time!");
+		return ReadAwaiter<T>{ *this, aOutData };
+	}
+
+	template<typename T>
+	inline void IncrementalReader::ReadAwaiter<T>::await_suspend(std::coroutine_handle<> aHandle) noexcept
+	{
+		reader.myWaiter				= aHandle;
+		reader.myPendingData		= std::addressof(data);
+		reader.myPendingProgress	= [](IncrementalReader& aReader, void* aData)
+		{
+			return aReader.Progress(*static_cast<T*>(aData));
+		};
+	}
+
+	template<typename T>
+	inline bool IncrementalReader::Progress(T& aOutData)
+	{
+		const std::span<const std::byte> bytes = myBuffer;
+
+		if (!ScanEncodedSize<T>(bytes, myOffset))
+			return false;
+
+		myOffset += SerializeImpl<T>{}.Read(aOutData, bytes, myOffset);
+
+		return true;
+	}
+
+	template<typename T, typename Alloc>
+	inline bool IncrementalReader::Progress(std::vector<T, Alloc>& aOutData)
+	{
+		const std::span<const std::byte> bytes = myBuffer;
+
+		if (myNumElements == NO_ELEMENTS)
+		{
+			std::size_t numElements = 0;
+			const std::optional<std::size_t> prefixBytes = ScanLength(numElements, bytes, myOffset);
+
+			if (!prefixBytes)
+				return false;
+
+			if (IsChunkedLayout<T>(numElements)) // chunks are decoded in parallel, which needs all of them
+			{
+				if (!ScanEncodedSize<std::vector<T, Alloc>>(bytes, myOffset))
+					return false;
+
+				myOffset += SerializeImpl<std::vector<T, Alloc>>{}.Read(aOutData, bytes, myOffset);
+
+				return true;
+			}
+
+			aOutData.resize(numElements);
+
+			myOffset		+= *prefixBytes;
+			myNumElements	= numElements;
+			myNextElement	= 0;
+		}
+
+		if constexpr (std::is_trivially_copyable_v<T> && !CompactInteger<T>) // every element that has arrived in one copy
+		{
+			const std::size_t numAvailable = std::min(myNumElements - myNextElement, (bytes.size() - myOffset) / sizeof(T));
+
+			std::byte* elements = reinterpret_cast<std::byte*>(aOutData.data() + myNextElement);
+
+			if constexpr (WireSwapped<T>)
+				SwapBytesElements<T>(elements, bytes.data() + myOffset, numAvailable);
+			else if (numAvailable != 0)
+				std::memcpy(elements, bytes.data() + myOffset, numAvailable * sizeof(T));
+
+			myOffset		+= numAvailable * sizeof(T);
+			myNextElement	+= numAvailable;
+		}
+		else
+		{
+			for (; myNextElement < myNumElements; ++myNextElement)
+			{
+				if (!ScanEncodedSize<T>(bytes, myOffset))
+					return false;
+
+				myOffset += SerializeImpl<T>{}.Read(aOutData[myNextElement], bytes, myOffset);
+			}
+		}
+
+		if (myNextElement != myNumElements)
+			return false;
+
+		myNumElements = NO_ELEMENTS;
+
+		return true;
+	}
+}
@@ -0,0 +1,362 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <bit>
+#include <span>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+
+#include <DaiSer/Config.h>
+#include <DaiSer/Utility/BitUtils.hpp>
+#include <DaiSer/Utility/ByteSwap.hpp>
+
+#include "Serializer.h"
+#include "BitSerializer.h"
+
+/// Vector encoding with an offset index so that single elements can be decoded without decoding the
+/// elements before them. The elements are grouped into blocks, every block has a fixed-size directory
+/// entry with the offset of its first element, and the offsets of the other elements in the block are
+/// bit-packed relative to it using only as many bits as the block needs.
+/// 
+/// Wire format: number of elements, size of the packed offsets, size of the elements, the directory,
+/// the packed offsets, and finally the elements as they would be written on their own.
+
+namespace DaiSer
+{
+	/// Number of elements that share a directory entry
+	/// 
+	inline constexpr std::size_t INDEX_BLOCK_SIZE = 64;
+
+	/// Writes the elements with an offset index, read back with LazyVector<T>
+	/// 
+	template<typename T>
+	class IndexedVector
+	{
+	public:
+		explicit IndexedVector(std::span<const T> aElements) noexcept : myElements(aElements) {}
+
+		template<typename Alloc>
+		explicit IndexedVector(const std::vector<T, Alloc>& aElements) noexcept : myElements(aElements) {}
+
+		NODISC std::span<const T> GetElements() const noexcept { return myElements; }
+
+	private:
+		std::span<const T> myElements;
+	};
+
+	template<typename T, typename Alloc>
+	IndexedVector(const std::vector<T, Alloc>&) -> IndexedVector<T>;
+
+	/// View of an indexed vector that decodes elements on demand. The view borrows the buffer it was
+	/// read from, which must outlive it. Not safe to use from multiple threads once elements are cached.
+	/// 
+	template<typename T>
+	class LazyVector
+	{
+	public:
+		LazyVector() = default;
+
+		NODISC std::size_t GetSize() const noexcept { return myNumElements; }
+		NODISC bool IsEmpty() const noexcept { return myNumElements == 0; }
+
+		/// Decodes the element into aOutData, which allows reusing its memory
+		/// 
+		void Get(std::size_t aIndex, T& aOutData) const;
+
+		/// Decodes the element, every call decodes it anew
+		/// 
+		NODISC T Get(std::size_t aIndex) const;
+
+		/// Decodes the element the first time it is requested and keeps it for later calls
+		/// 
+		NODISC const T& GetCached(std::size_t aIndex) const;
+
+		void ClearCache() noexcept { myCache.clear(); }
+
+		/// Decodes every element
+		/// 
+		NODISC std::vector<T> ToVector() const;
+
+	private:
+		NODISC std::size_t GetOffset(std::size_t aIndex) const;
+
+		std::span<const std::byte>				myBuffer;
+		std::size_t								myNumElements		= 0;
+		std::size_t								myDirectoryOffset	= 0;
+		std::size_t								myPackedOffset		= 0;
+		std::size_t								myPayloadOffset		= 0;
+		mutable std::unordered_map<std::size_t, T>	myCache;
+
+		friend struct SerializeImpl<LazyVector<T>>;
+	};
+
+	template<typename T>
+	struct SerializeImpl<IndexedVector<T>>
+	{
+		NODISC std::size_t Size(const IndexedVector<T>& aInData) const
+			requires (Measurable<T>);
+
+		template<ByteSink Sink>
+		NODISC std::size_t Write(const IndexedVector<T>& aInData, Sink& aOutSink, std::size_t aOffset);
+	};
+
+	template<typename T>
+	struct SerializeImpl<LazyVector<T>>
+	{
+		/// Only reads the header, the elements are skipped and decoded by the view when requested
+		/// 
+		NODISC std::size_t Read(LazyVector<T>& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset);
+	};
+
+	/// The directory entry of a block is its first element's offset from the start of the elements, and the bit
+	/// position of its packed offsets shifted up next to the number of bits that every packed offset uses
+	/// 
+	inline constexpr std::size_t INDEX_ENTRY_SIZE	= 2 * sizeof(std::uint64_t);
+	inline constexpr std::uint32_t INDEX_WIDTH_BITS	= 6;
+	inline constexpr std::uint32_t INDEX_MAX_WIDTH	= 57; // packed offsets are extracted from a single 64-bit load at any bit position
+
+	/// Padding after the packed offsets so that the 64-bit load never reads past them
+	/// 
+	inline constexpr std::size_t INDEX_PACKED_PADDING = sizeof(std::uint64_t);
+
+	inline void StoreIndexWord(std::byte* aOut, std::uint64_t aValue) noexcept
+	{
+		if constexpr (WIRE_ENDIAN != std::endian::native)
+			aValue = ByteSwap(aValue);
+
+		std::memcpy(aOut, &aValue, sizeof(aValue));
+	}
+
+	NODISC inline std::uint64_t LoadIndexWord(const std::byte* aIn) noexcept
+	{
+		std::uint64_t value;
+		std::memcpy(&value, aIn, sizeof(value));
+
+		if constexpr (WIRE_ENDIAN != std::endian::native)
+			value = ByteSwap(value);
+
+		return value;
+	}
+
+	/// Number of bits needed for the offsets relative to the first element in the block
+	/// 
+	NODISC inline std::uint32_t IndexBlockWidth(std::size_t aFirstOffset, std::size_t aLastOffset) noexcept
+	{
+		const std::uint32_t width = static_cast<std::uint32_t>(std::bit_width(aLastOffset - aFirstOffset));
+		assert(width <= INDEX_MAX_WIDTH && "Block of elements is too large to be indexed!");
+
+		return width;
+	}
+
+	template<typename T>
+	inline std::size_t SerializeImpl<IndexedVector<T>>::Size(const IndexedVector<T>& aInData) const
+		requires (Measurable<T>)
+	{
+		const std::span<const T> elements = aInData.GetElements();
+		const std::size_t numBlocks = (elements.size() + INDEX_BLOCK_SIZE - 1) / INDEX_BLOCK_SIZE;
+
+		std::size_t payloadBytes	= 0;
+		std::size_t packedBits		= 0;
+
+		for (std::size_t block = 0; block < numBlocks; ++block)
+		{
+			const std::size_t first = block * INDEX_BLOCK_SIZE;
+			const std::size_t last	= std::min(first + INDEX_BLOCK_SIZE, elements.size());
+
+			const std::size_t firstOffset = payloadBytes;
+
+			for (std::size_t i = first; i < last - 1; ++i)
+				payloadBytes += SerializeImpl<T>{}.Size(elements[i]);
+
+			packedBits += (last - first - 1) * IndexBlockWidth(firstOffset, payloadBytes);
+			payloadBytes += SerializeImpl<T>{}.Size(elements[last - 1]);
+		}
+
+		const std::size_t packedBytes = (packedBits + 7) / 8 + INDEX_PACKED_PADDING;
+
+		return LengthSize(elements.size()) + LengthSize(packedBytes) + LengthSize(payloadBytes) +
+			numBlocks * INDEX_ENTRY_SIZE + packedBytes + payloadBytes;
+	}
+
+	template<typename T>
+	template<ByteSink Sink>
+	inline std::size_t SerializeImpl<IndexedVector<T>>::Write(const IndexedVector<T>& aInData, Sink& aOutSink, std::size_t aOffset)
+	{
+		StringTableScope noTable(nullptr); // the elements are measured and read in any order
+
+		const std::span<const T> elements = aInData.GetElements();
+
+		const std::size_t numElements	= elements.size();
+		const std::size_t numBlocks		= (numElements + INDEX_BLOCK_SIZE - 1) / INDEX_BLOCK_SIZE;
+
+		// offsets from the start of the elements, types that cannot be measured are written to the side first
+		std::vector<std::size_t> offsets(numElements + 1);
+		ByteBuffer payload;
+
+		for (std::size_t i = 0; i < numElements; ++i)
+		{
+			if constexpr (Measurable<T>)
+				offsets[i + 1] = offsets[i] + SerializeImpl<T>{}.Size(elements[i]);
+			else
+				offsets[i + 1] = offsets[i] + SerializeImpl<T>{}.Write(elements[i], payload, offsets[i]);
+		}
+
+		std::vector<std::uint64_t> directory(numBlocks * 2);
+		BitWriteSerializer packed;
+
+		for (std::size_t block = 0; block < numBlocks; ++block)
+		{
+			const std::size_t first = block * INDEX_BLOCK_SIZE;
+			const std::size_t last	= std::min(first + INDEX_BLOCK_SIZE, numElements);
+
+			const std::uint32_t width = IndexBlockWidth(offsets[first], offsets[last - 1]);
+
+			directory[block * 2 + 0] = offsets[first];
+			directory[block * 2 + 1] = (static_cast<std::uint64_t>(packed.GetNumBits()) << INDEX_WIDTH_BITS) | width;
+
+			for (std::size_t i = first + 1; i < last; ++i) // the first element is at the anchor
+				packed.SerializeBits(offsets[i] - offsets[first], width);
+		}
+
+		const std::span<const std::byte> packedBits = packed.GetBuffer();
+
+		const std::size_t packedBytes	= packedBits.size() + INDEX_PACKED_PADDING;
+		const std::size_t payloadBytes	= offsets[numElements];
+
+		std::size_t numBytes = WriteLength(numElements, aOutSink, aOffset);
+		numBytes += WriteLength(packedBytes, aOutSink, aOffset + numBytes);
+		numBytes += WriteLength(payloadBytes, aOutSink, aOffset + numBytes);
+
+		std::byte* index = aOutSink.Prepare(aOffset + numBytes, numBlocks * INDEX_ENTRY_SIZE + packedBytes);
+
+		for (std::size_t i = 0; i < directory.size(); ++i)
+			StoreIndexWord(index + i * sizeof(std::uint64_t), directory[i]);
+
+		index += numBlocks * INDEX_ENTRY_SIZE;
+
+		if (!packedBits.empty())
+			std::memcpy(index, packedBits.data(), packedBits.size());
+
+		std::memset(index + packedBits.size(), 0, INDEX_PACKED_PADDING);
+
+		numBytes += numBlocks * INDEX_ENTRY_SIZE + packedBytes;
+
+		if constexpr (Measurable<T>)
+		{
+			for (std::size_t i = 0; i < numElements; ++i)
+			{
+				UNSD const std::size_t written = SerializeImpl<T>{}.Write(elements[i], aOutSink, aOffset + numBytes + offsets[i]);
+				assert(written == offsets[i + 1] - offsets[i] && "Size does not match the written bytes!");
+			}
+		}
+		else if (payloadBytes != 0)
+		{
+			std::memcpy(aOutSink.Prepare(aOffset + numBytes, payloadBytes), payload.GetData(), payloadBytes);
+		}
+
+		return numBytes + payloadBytes;
+	}
+
+	template<typename T>
+	inline std::size_t SerializeImpl<LazyVector<T>>::Read(LazyVector<T>& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset)
+	{
+		std::size_t numElements		= 0;
+		std::size_t packedBytes		= 0;
+		std::size_t payloadBytes	= 0;
+
+		std::size_t numBytes = ReadLength(numElements, aInBytes, aOffset);
+		numBytes += ReadLength(packedBytes, aInBytes, aOffset + numBytes);
+		numBytes += ReadLength(payloadBytes, aInBytes, aOffset + numBytes);
+
+		const std::size_t numBlocks = (numElements + INDEX_BLOCK_SIZE - 1) / INDEX_BLOCK_SIZE;
+
+		aOutData.myBuffer			= aInBytes;
+		aOutData.myNumElements		= numElements;
+		aOutData.myDirectoryOffset	= aOffset + numBytes;
+		aOutData.myPackedOffset		= aOutData.myDirectoryOffset + numBlocks * INDEX_ENTRY_SIZE;
+		aOutData.myPayloadOffset	= aOutData.myPackedOffset + packedBytes;
+		aOutData.myCache.clear();
+
+		assert(packedBytes >= INDEX_PACKED_PADDING && aOutData.myPayloadOffset + payloadBytes <= aInBytes.size() && "Not enough memory to read from!");
+
+		return aOutData.myPayloadOffset + payloadBytes - aOffset;
+	}
+
+	template<typename T>
+	inline void LazyVector<T>::Get(std::size_t aIndex, T& aOutData) const
+	{
+		StringTableScope noTable(nullptr);
+		UNSD const std::size_t numBytes = SerializeImpl<T>{}.Read(aOutData, myBuffer, GetOffset(aIndex));
+	}
+
+	template<typename T>
+	inline T LazyVector<T>::Get(std::size_t aIndex) const
+	{
+		T result{};
+		Get(aIndex, result);
+
+		return result;
+	}
+
+	template<typename T>
+	inline const T& LazyVector<T>::GetCached(std::size_t aIndex) const
+	{
+		const auto [it, inserted] = myCache.try_emplace(aIndex);
+
+		if (inserted)
+			Get(aIndex, it->second);
+
+		return it->second;
+	}
+
+	template<typename T>
+	inline std::vector<T> LazyVector<T>::ToVector() const
+	{
+		std::vector<T> result(myNumElements);
+
+		StringTableScope noTable(nullptr);
+
+		// the elements are contiguous, so they are simply read one after another
+		std::size_t offset = myPayloadOffset;
+		for (T& element : result)
+			offset += SerializeImpl<T>{}.Read(element, myBuffer, offset);
+
+		return result;
+	}
+
+	template<typename T>
+	inline std::size_t LazyVector<T>::GetOffset(std::size_t aIndex) const
+	{
+		assert(aIndex < myNumElements && "Index is out of range!");
+
+		const std::size_t block = aIndex / INDEX_BLOCK_SIZE;
+		const std::size_t index = aIndex % INDEX_BLOCK_SIZE;
+
+		const std::byte* entry = myBuffer.data() + myDirectoryOffset + block * INDEX_ENTRY_SIZE;
+
+		const std::size_t anchor = static_cast<std::size_t>(LoadIndexWord(entry));
+
+		if (index == 0)
+			return myPayloadOffset + anchor;
+
+		const std::uint64_t packed = LoadIndexWord(entry + sizeof(std::uint64_t));
+
+		const std::uint32_t width	= static_cast<std::uint32_t>(packed & LowBitMask(INDEX_WIDTH_BITS));
+		const std::uint64_t bit		= (packed >> INDEX_WIDTH_BITS) + (index - 1) * width;
+
+		// packed bits are always little-endian, see BitWriteSerializer
+		std::uint64_t word;
+		std::memcpy(&word, myBuffer.data() + myPackedOffset + bit / 8, sizeof(word));
+
+		if constexpr (std::endian::native == std::endian::big)
+			word = ByteSwap(word);
+
+		const std::size_t relative = static_cast<std::size_t>((word >> (bit % 8)) & LowBitMask(width));
+
+		return myPayloadOffset + anchor + relative;
+	}
+}
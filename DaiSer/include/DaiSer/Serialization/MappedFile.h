@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <filesystem>
+
+#include <DaiSer/Config.h>
+
+namespace DaiSer
+{
+	/// Read-only memory mapping of an entire file, pages are loaded on demand by the OS as they are
+	/// touched. Moving the mapping does not move the mapped memory, so views into it stay valid.
+	/// 
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+
+		/// Throws std::runtime_error if the file could not be opened or mapped
+		/// 
+		DAISER_API explicit MappedFile(const std::filesystem::path& aPath);
+
+		DAISER_API ~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		DAISER_API MappedFile(MappedFile&& aOther) noexcept;
+		DAISER_API MappedFile& operator=(MappedFile&& aOther) noexcept;
+
+		NODISC const std::byte* GetData() const noexcept { return myData; }
+		NODISC std::size_t GetSize() const noexcept { return mySize; }
+
+		NODISC operator std::span<const std::byte>() const noexcept { return { myData, mySize }; }
+
+		DAISER_API void Close() noexcept;
+
+	private:
+		const std::byte*	myData	= nullptr;
+		std::size_t			mySize	= 0;
+
+#ifdef DAISER_SYSTEM_WIN
+		void*				myFileHandle	= nullptr;
+		void*				myMappingHandle	= nullptr;
+#endif
+	};
+}
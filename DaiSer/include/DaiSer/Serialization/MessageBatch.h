@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <deque>
+#include <vector>
+#include <optional>
+
+#include <DaiSer/Config.h>
+
+#include "Serializer.h"
+#include "OutputSink.h"
+
+/// Batching of many small messages into a few large buffers for gather output. Every message is
+/// written as a frame, a little-endian 32-bit payload size followed by the payload, straight into
+/// a chunk of a ring of buffers:
+/// 
+///		batch.Write(header, body);
+///		...
+///		std::array<IoSlice, 64> slices;
+///		const std::size_t numSlices = batch.Gather(slices);
+///		batch.Consume(writev(socket, reinterpret_cast<const iovec*>(slices.data()), numSlices));
+/// 
+/// Sent chunks keep their memory and are reused for later frames. On the receiving side, FrameReader
+/// splits the bytes back into one ReadSerializer per message without copying them.
+
+namespace DaiSer
+{
+	inline constexpr std::size_t FRAME_HEADER_SIZE = 4;
+
+	/// Pending memory to send, same layout as iovec on POSIX systems
+	/// 
+	struct IoSlice
+	{
+		const void*	base	= nullptr;
+		std::size_t	length	= 0;
+	};
+
+	class MessageBatch
+	{
+	public:
+		static constexpr std::size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+		DAISER_API explicit MessageBatch(std::size_t aChunkSize = DEFAULT_CHUNK_SIZE);
+
+		/// Writes the values as a single frame, a frame is never split between chunks
+		/// 
+		template<typename... Ts>
+		void Write(const Ts&... aInData);
+
+		/// Fills the slices with the pending bytes in order and returns the number of slices filled, the
+		/// slices stay valid until the next call to Write or Consume
+		/// 
+		NODISC DAISER_API std::size_t Gather(std::span<IoSlice> aOutSlices) const;
+
+		/// Marks the bytes at the front as sent, e.g., the return value of writev, chunks that have been
+		/// sent completely are kept for reuse
+		/// 
+		DAISER_API void Consume(std::size_t aNumBytes);
+
+		NODISC std::size_t GetPendingBytes() const noexcept { return myPendingBytes; }
+		NODISC std::size_t GetNumPendingChunks() const noexcept { return myChunks.size(); }
+
+		NODISC bool IsEmpty() const noexcept { return myPendingBytes == 0; }
+
+	private:
+		/// Returns the chunk to write the next frame to, with at least aNumBytes of room if known up front
+		/// 
+		NODISC DAISER_API ByteBuffer& BeginFrame(std::size_t aNumBytes);
+
+		DAISER_API void EndFrame(ByteBuffer& aChunk, std::size_t aFrameOffset, std::size_t aEndOffset);
+
+		std::deque<ByteBuffer>	myChunks;			// pending, the front is sent first
+		std::vector<ByteBuffer>	myFreeChunks;		// sent, kept to be reused
+		std::size_t				myChunkSize		= 0;
+		std::size_t				myFrontOffset	= 0;	// bytes of the front chunk that have already been sent
+		std::size_t				myPendingBytes	= 0;
+	};
+
+	/// Splits a stream of frames written by MessageBatch into messages, every message is read straight
+	/// from the stream, which must therefore outlive the returned serializers.
+	/// 
+	class FrameReader
+	{
+	public:
+		explicit FrameReader(std::span<const std::byte> aStream) noexcept
+			: myStream(aStream) {}
+
+		/// Returns the next message, or nothing if the rest of the stream does not hold a complete frame
+		/// 
+		NODISC DAISER_API std::optional<ReadSerializer> Next();
+
+		/// Number of bytes of complete frames that have been returned
+		/// 
+		NODISC std::size_t GetConsumed() const noexcept { return myOffset; }
+
+		/// Bytes of a partially received frame, to be kept until the rest of it arrives
+		/// 
+		NODISC std::span<const std::byte> GetRemaining() const noexcept { return myStream.subspan(myOffset); }
+
+	private:
+		std::span<const std::byte>	myStream;
+		std::size_t					myOffset = 0;
+	};
+
+	template<typename... Ts>
+	inline void MessageBatch::Write(const Ts&... aInData)
+	{
+		if constexpr ((Measurable<std::decay_t<Ts>> && ...))
+		{
+			const std::size_t numBytes = (SerializeImpl<std::decay_t<Ts>>{}.Size(aInData) + ... + 0);
+
+			ByteBuffer& chunk = BeginFrame(FRAME_HEADER_SIZE + numBytes);
+
+			const std::size_t frameOffset = chunk.GetSize();
+			std::size_t offset = frameOffset + FRAME_HEADER_SIZE;
+
+			UncheckedSink sink(chunk.Prepare(frameOffset, FRAME_HEADER_SIZE + numBytes), FRAME_HEADER_SIZE + numBytes, frameOffset);
+			((offset += SerializeImpl<std::decay_t<Ts>>{}.Write(aInData, sink, offset)), ...);
+
+			EndFrame(chunk, frameOffset, offset);
+		}
+		else
+		{
+			ByteBuffer& chunk = BeginFrame(FRAME_HEADER_SIZE);
+
+			const std::size_t frameOffset = chunk.GetSize();
+			std::size_t offset = frameOffset + FRAME_HEADER_SIZE;
+
+			(void)chunk.Prepare(frameOffset, FRAME_HEADER_SIZE);
+			((offset += SerializeImpl<std::decay_t<Ts>>{}.Write(aInData, chunk, offset)), ...); // grows the chunk if it runs out of room
+
+			EndFrame(chunk, frameOffset, offset);
+		}
+	}
+}
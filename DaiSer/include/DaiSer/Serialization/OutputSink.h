@@ -0,0 +1,198 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <vector>
+#include <concepts>
+#include <stdexcept>
+#include <algorithm>
+
+#include <DaiSer/Config.h>
+
+/// Output sinks are the destinations that SerializeImpl writes to. A sink only needs to expose
+/// Prepare(offset, numBytes), which returns writable memory for the given range and grows the
+/// sink if required. Size (the furthest byte written) and capacity are tracked separately so that
+/// growth is amortized and no memory is zero-filled before being overwritten.
+
+namespace DaiSer
+{
+	template<typename S>
+	concept ByteSink = requires(S& aSink, std::size_t aOffset, std::size_t aNumBytes)
+	{
+		{ aSink.Prepare(aOffset, aNumBytes) } -> std::same_as<std::byte*>;
+	};
+
+	/// Sinks that only hold a window of the output in memory, e.g., FileSink. Writes are passed to them in 
+	/// pieces that fit the window, and bytes that are copied as they are go through Write so that the sink
+	/// can hand them on without holding them.
+	/// 
+	template<typename S>
+	concept WindowedSink = ByteSink<S> && requires(S& aSink, std::size_t aOffset, const std::byte* aData, std::size_t aNumBytes)
+	{
+		{ aSink.GetWindowSize() } -> std::convertible_to<std::size_t>;
+		aSink.Write(aOffset, aData, aNumBytes);
+	};
+
+	/// Largest number of bytes that should be prepared at once
+	/// 
+	template<ByteSink Sink>
+	NODISC inline std::size_t MaxPrepareSize(const Sink& aSink) noexcept
+	{
+		if constexpr (WindowedSink<Sink>)
+			return std::max<std::size_t>(1, aSink.GetWindowSize());
+		else
+			return SIZE_MAX;
+	}
+
+	/// Copies the bytes to the sink at the offset
+	/// 
+	template<ByteSink Sink>
+	inline void WriteBytes(Sink& aOutSink, std::size_t aOffset, const std::byte* aData, std::size_t aNumBytes)
+	{
+		if constexpr (WindowedSink<Sink>)
+			aOutSink.Write(aOffset, aData, aNumBytes);
+		else if (aNumBytes != 0)
+			std::memcpy(aOutSink.Prepare(aOffset, aNumBytes), aData, aNumBytes);
+	}
+
+	/// Owning, growable byte storage with geometric growth and uninitialized capacity
+	/// 
+	class ByteBuffer
+	{
+	public:
+		ByteBuffer() = default;
+		DAISER_API explicit ByteBuffer(std::size_t aCapacity);
+		DAISER_API ByteBuffer(std::span<const std::byte> aBytes);
+
+		DAISER_API ByteBuffer(const ByteBuffer& aOther);
+		DAISER_API ByteBuffer(ByteBuffer&& aOther) noexcept;
+
+		DAISER_API ByteBuffer& operator=(const ByteBuffer& aOther);
+		DAISER_API ByteBuffer& operator=(ByteBuffer&& aOther) noexcept;
+
+		NODISC std::byte* GetData() noexcept { return myData.get(); }
+		NODISC const std::byte* GetData() const noexcept { return myData.get(); }
+
+		NODISC std::size_t GetSize() const noexcept { return mySize; }
+		NODISC std::size_t GetCapacity() const noexcept { return myCapacity; }
+
+		NODISC bool IsEmpty() const noexcept { return mySize == 0; }
+
+		NODISC operator std::span<const std::byte>() const noexcept { return { myData.get(), mySize }; }
+		NODISC operator std::span<std::byte>() noexcept { return { myData.get(), mySize }; }
+
+		/// Returns writable memory for [aOffset, aOffset + aNumBytes), growing the buffer if required
+		/// 
+		NODISC std::byte* Prepare(std::size_t aOffset, std::size_t aNumBytes);
+
+		/// Marks [0, aSize) as written, assumes the capacity has already been reserved
+		/// 
+		void Commit(std::size_t aSize) noexcept;
+
+		DAISER_API void Reserve(std::size_t aCapacity);
+
+		/// Changes the size without initializing any new bytes
+		/// 
+		DAISER_API void Resize(std::size_t aSize);
+
+		DAISER_API void ShrinkToFit();
+
+		void Clear() noexcept { mySize = 0; }
+
+		NODISC DAISER_API std::vector<std::byte> ToVector() const;
+
+	private:
+		DAISER_API void Grow(std::size_t aMinCapacity);
+
+		std::unique_ptr<std::byte[]>	myData;
+		std::size_t						mySize		= 0;
+		std::size_t						myCapacity	= 0;
+	};
+
+	/// Writes into caller provided memory, throws std::length_error if the memory is exhausted
+	/// 
+	class SpanSink
+	{
+	public:
+		SpanSink(std::span<std::byte> aBytes) noexcept
+			: myData(aBytes.data()), myCapacity(aBytes.size()) {}
+
+		NODISC std::byte* GetData() const noexcept { return myData; }
+
+		NODISC std::size_t GetSize() const noexcept { return mySize; }
+		NODISC std::size_t GetCapacity() const noexcept { return myCapacity; }
+
+		NODISC std::span<std::byte> GetWritten() const noexcept { return { myData, mySize }; }
+
+		NODISC std::byte* Prepare(std::size_t aOffset, std::size_t aNumBytes);
+
+		void Clear() noexcept { mySize = 0; }
+
+	private:
+		std::byte*	myData		= nullptr;
+		std::size_t	mySize		= 0;
+		std::size_t	myCapacity	= 0;
+	};
+
+	/// Writes straight to memory without any capacity checks or size tracking, the caller is
+	/// responsible for having reserved enough memory and for committing the written size afterwards.
+	/// aBaseOffset is the offset that aData corresponds to.
+	/// 
+	class UncheckedSink
+	{
+	public:
+		UncheckedSink(std::byte* aData, UNSD std::size_t aNumBytes, std::size_t aBaseOffset = 0) noexcept
+			: myData(aData), myBaseOffset(aBaseOffset)
+#ifndef NDEBUG
+			, myEndOffset(aBaseOffset + aNumBytes)
+#endif
+		{}
+
+		NODISC std::byte* Prepare(std::size_t aOffset, UNSD std::size_t aNumBytes) const noexcept
+		{
+			assert(aOffset >= myBaseOffset && aOffset + aNumBytes <= myEndOffset && "Write outside of reserved memory!");
+			return myData + (aOffset - myBaseOffset);
+		}
+
+	private:
+		std::byte*	myData			= nullptr;
+		std::size_t	myBaseOffset	= 0;
+#ifndef NDEBUG
+		std::size_t	myEndOffset		= 0;
+#endif
+	};
+
+	inline std::byte* ByteBuffer::Prepare(std::size_t aOffset, std::size_t aNumBytes)
+	{
+		const std::size_t end = aOffset + aNumBytes;
+
+		if (end > myCapacity) [[unlikely]]
+			Grow(end);
+
+		mySize = std::max(mySize, end);
+
+		return myData.get() + aOffset;
+	}
+
+	inline void ByteBuffer::Commit(std::size_t aSize) noexcept
+	{
+		assert(aSize <= myCapacity && "Cannot commit more than the reserved capacity!");
+		mySize = std::max(mySize, aSize);
+	}
+
+	inline std::byte* SpanSink::Prepare(std::size_t aOffset, std::size_t aNumBytes)
+	{
+		const std::size_t end = aOffset + aNumBytes;
+
+		if (end > myCapacity) [[unlikely]]
+			throw std::length_error("SpanSink: not enough memory to write to");
+
+		mySize = std::max(mySize, end);
+
+		return myData + aOffset;
+	}
+}
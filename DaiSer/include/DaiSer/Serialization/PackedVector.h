@@ -0,0 +1,282 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+#include <algorithm>
+
+#include <DaiSer/Config.h>
+#include <DaiSer/Utility/BitUtils.hpp>
+
+#include "Serializer.h"
+
+/// Bit-packed encoding of integer vectors. The values are grouped into blocks, and every block is written
+/// either relative to its smallest value (frame of reference) or as the differences between consecutive
+/// values relative to the smallest difference (delta), whichever needs fewer bits, and then packed at that
+/// width. Sorted or slowly changing values, e.g., timestamps and IDs, take a few bits per value.
+///
+/// Wire format: number of values, then for every block a byte with the delta flag in the high bit and the
+/// width in the others, the reference as a varint (the smallest value, or the smallest difference zigzagged),
+/// and the packed values in little-endian bit order. The blocks are followed by PACKED_PADDING zero bytes.
+
+namespace DaiSer
+{
+	/// Number of values that share a width and a reference
+	/// 
+	inline constexpr std::size_t PACKED_BLOCK_SIZE = 128;
+
+	/// Padding after the last block so that unpacking can always load a whole word
+	/// 
+	inline constexpr std::size_t PACKED_PADDING = sizeof(std::uint64_t);
+
+	/// How a block is written, the values being integers mapped to std::uint64_t with their order kept
+	/// 
+	struct PackedBlockPlan
+	{
+		std::uint64_t	reference	= 0;
+		std::uint32_t	width		= 0;
+		bool			isDelta		= false;
+
+		NODISC std::size_t GetNumBytes(std::size_t aNumValues) const noexcept
+		{
+			return 1 + VarIntSize(reference) + (aNumValues * width + 7) / 8;
+		}
+	};
+
+	/// Picks the encoding of the block that needs the fewest bits, aPrevious is the last value of the block before
+	/// 
+	NODISC DAISER_API PackedBlockPlan PlanPackedBlock(const std::uint64_t* aValues, std::size_t aNumValues, std::uint64_t aPrevious) noexcept;
+
+	/// Writes the block, aOutBytes must fit aPlan.GetNumBytes(aNumValues) bytes
+	/// 
+	DAISER_API void EncodePackedBlock(const PackedBlockPlan& aPlan, const std::uint64_t* aValues, std::size_t aNumValues, std::uint64_t aPrevious, std::byte* aOutBytes) noexcept;
+
+	/// Reads the block at the offset into aOutValues, returns the number of bytes read
+	/// 
+	DAISER_API std::size_t DecodePackedBlock(std::span<const std::byte> aInBytes, std::size_t aOffset, std::size_t aNumValues, std::uint64_t aPrevious, std::uint64_t* aOutValues) noexcept;
+
+	/// Returns the number of bytes of the block at the offset without decoding it
+	/// 
+	NODISC DAISER_API std::size_t SkipPackedBlock(std::span<const std::byte> aInBytes, std::size_t aOffset, std::size_t aNumValues) noexcept;
+
+	/// Maps the integer to std::uint64_t so that the order of values is kept, signed values are offset by 2^63
+	/// 
+	template<RangedValue T>
+	NODISC constexpr std::uint64_t ToPackedValue(T aValue) noexcept
+	{
+		if constexpr (std::is_enum_v<T>)
+			return ToPackedValue(static_cast<std::underlying_type_t<T>>(aValue));
+		else if constexpr (std::is_signed_v<T>)
+			return static_cast<std::uint64_t>(static_cast<std::int64_t>(aValue)) ^ (1ULL << 63);
+		else
+			return static_cast<std::uint64_t>(aValue);
+	}
+
+	template<RangedValue T>
+	NODISC constexpr T FromPackedValue(std::uint64_t aValue) noexcept
+	{
+		if constexpr (std::is_enum_v<T>)
+			return static_cast<T>(FromPackedValue<std::underlying_type_t<T>>(aValue));
+		else if constexpr (std::is_signed_v<T>)
+			return static_cast<T>(static_cast<std::int64_t>(aValue ^ (1ULL << 63)));
+		else
+			return static_cast<T>(aValue);
+	}
+
+	/// Writes the integers bit-packed, read back with PackedView<T>
+	/// 
+	template<RangedValue T>
+	class PackedVector
+	{
+	public:
+		explicit PackedVector(std::span<const T> aValues) noexcept : myValues(aValues) {}
+
+		template<typename Alloc>
+		explicit PackedVector(const std::vector<T, Alloc>& aValues) noexcept : myValues(aValues) {}
+
+		NODISC std::span<const T> GetValues() const noexcept { return myValues; }
+
+	private:
+		std::span<const T> myValues;
+	};
+
+	template<typename T, typename Alloc>
+	PackedVector(const std::vector<T, Alloc>&) -> PackedVector<T>;
+
+	/// View of bit-packed integers that are unpacked when requested. The view borrows the buffer it was read
+	/// from, which must outlive it.
+	/// 
+	template<RangedValue T>
+	class PackedView
+	{
+	public:
+		PackedView() = default;
+
+		NODISC std::size_t GetSize() const noexcept { return myNumValues; }
+		NODISC bool IsEmpty() const noexcept { return myNumValues == 0; }
+
+		/// Unpacks every value into aOutValues, which allows reusing its memory
+		/// 
+		template<typename Alloc>
+		void ToVector(std::vector<T, Alloc>& aOutValues) const;
+
+		NODISC std::vector<T> ToVector() const;
+
+	private:
+		std::span<const std::byte>	myBuffer;
+		std::size_t					myNumValues		= 0;
+		std::size_t					myBlocksOffset	= 0;
+
+		friend struct SerializeImpl<PackedView<T>>;
+	};
+
+	template<RangedValue T>
+	struct SerializeImpl<PackedVector<T>>
+	{
+		NODISC std::size_t Size(const PackedVector<T>& aInData) const;
+
+		template<ByteSink Sink>
+		NODISC std::size_t Write(const PackedVector<T>& aInData, Sink& aOutSink, std::size_t aOffset);
+	};
+
+	template<RangedValue T>
+	struct SerializeImpl<PackedView<T>>
+	{
+		/// Only reads the block headers, the values are unpacked by the view when requested
+		/// 
+		NODISC std::size_t Read(PackedView<T>& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset);
+	};
+
+	/// Calls the function with every block of values mapped by ToPackedValue and the last value of the block before
+	/// 
+	template<RangedValue T, typename Func>
+	inline void ForEachPackedBlock(std::span<const T> aValues, Func&& aFunc)
+	{
+		std::uint64_t block[PACKED_BLOCK_SIZE];
+		std::uint64_t previous = 0;
+
+		for (std::size_t first = 0; first < aValues.size(); first += PACKED_BLOCK_SIZE)
+		{
+			const std::size_t numValues = std::min(PACKED_BLOCK_SIZE, aValues.size() - first);
+
+			const std::uint64_t* values = block;
+
+			if constexpr (std::is_same_v<T, std::uint64_t>)
+			{
+				values = aValues.data() + first;
+			}
+			else
+			{
+				for (std::size_t i = 0; i < numValues; ++i)
+					block[i] = ToPackedValue(aValues[first + i]);
+			}
+
+			aFunc(values, numValues, previous);
+			previous = values[numValues - 1];
+		}
+	}
+
+	template<RangedValue T>
+	inline std::size_t SerializeImpl<PackedVector<T>>::Size(const PackedVector<T>& aInData) const
+	{
+		const std::span<const T> values = aInData.GetValues();
+
+		std::size_t numBytes = LengthSize(values.size());
+
+		ForEachPackedBlock(values, [&numBytes](const std::uint64_t* aBlock, std::size_t aNumValues, std::uint64_t aPrevious)
+		{
+			numBytes += PlanPackedBlock(aBlock, aNumValues, aPrevious).GetNumBytes(aNumValues);
+		});
+
+		return values.empty() ? numBytes : numBytes + PACKED_PADDING;
+	}
+
+	template<RangedValue T>
+	template<ByteSink Sink>
+	inline std::size_t SerializeImpl<PackedVector<T>>::Write(const PackedVector<T>& aInData, Sink& aOutSink, std::size_t aOffset)
+	{
+		const std::span<const T> values = aInData.GetValues();
+
+		std::size_t numBytes = WriteLength(values.size(), aOutSink, aOffset);
+
+		if (values.empty())
+			return numBytes;
+
+		ForEachPackedBlock(values, [&](const std::uint64_t* aBlock, std::size_t aNumValues, std::uint64_t aPrevious)
+		{
+			const PackedBlockPlan plan = PlanPackedBlock(aBlock, aNumValues, aPrevious);
+			const std::size_t blockBytes = plan.GetNumBytes(aNumValues);
+
+			EncodePackedBlock(plan, aBlock, aNumValues, aPrevious, aOutSink.Prepare(aOffset + numBytes, blockBytes));
+			numBytes += blockBytes;
+		});
+
+		std::memset(aOutSink.Prepare(aOffset + numBytes, PACKED_PADDING), 0, PACKED_PADDING);
+
+		return numBytes + PACKED_PADDING;
+	}
+
+	template<RangedValue T>
+	inline std::size_t SerializeImpl<PackedView<T>>::Read(PackedView<T>& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset)
+	{
+		std::size_t numValues = 0;
+		std::size_t numBytes = ReadLength(numValues, aInBytes, aOffset);
+
+		aOutData.myBuffer		= aInBytes;
+		aOutData.myNumValues	= numValues;
+		aOutData.myBlocksOffset	= aOffset + numBytes;
+
+		if (numValues == 0)
+			return numBytes;
+
+		for (std::size_t first = 0; first < numValues; first += PACKED_BLOCK_SIZE)
+			numBytes += SkipPackedBlock(aInBytes, aOffset + numBytes, std::min(PACKED_BLOCK_SIZE, numValues - first));
+
+		assert(aOffset + numBytes + PACKED_PADDING <= aInBytes.size() && "Not enough memory to read from!");
+
+		return numBytes + PACKED_PADDING;
+	}
+
+	template<RangedValue T>
+	template<typename Alloc>
+	inline void PackedView<T>::ToVector(std::vector<T, Alloc>& aOutValues) const
+	{
+		aOutValues.resize(myNumValues);
+
+		std::uint64_t block[PACKED_BLOCK_SIZE];
+		std::uint64_t previous = 0;
+
+		std::size_t offset = myBlocksOffset;
+
+		for (std::size_t first = 0; first < myNumValues; first += PACKED_BLOCK_SIZE)
+		{
+			const std::size_t numValues = std::min(PACKED_BLOCK_SIZE, myNumValues - first);
+
+			if constexpr (std::is_same_v<T, std::uint64_t>) // unpacked in place
+			{
+				offset += DecodePackedBlock(myBuffer, offset, numValues, previous, aOutValues.data() + first);
+				previous = aOutValues[first + numValues - 1];
+			}
+			else
+			{
+				offset += DecodePackedBlock(myBuffer, offset, numValues, previous, block);
+				previous = block[numValues - 1];
+
+				for (std::size_t i = 0; i < numValues; ++i)
+					aOutValues[first + i] = FromPackedValue<T>(block[i]);
+			}
+		}
+	}
+
+	template<RangedValue T>
+	inline std::vector<T> PackedView<T>::ToVector() const
+	{
+		std::vector<T> result;
+		ToVector(result);
+
+		return result;
+	}
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+#include <DaiSer/Config.h>
+
+namespace DaiSer
+{
+	/// Runs the task for every index in [0, aNumTasks) on as many threads as the hardware has, the 
+	/// calling thread takes part. Blocks until all tasks are done and rethrows the first exception 
+	/// thrown by a task.
+	/// 
+	/// The threads are started on the first call and reused. Calls made from within a task, and calls
+	/// made while another thread is using the threads, run their tasks on the calling thread.
+	/// 
+	DAISER_API void ParallelFor(std::size_t aNumTasks, const std::function<void(std::size_t)>& aTask);
+}
@@ -1,13 +1,32 @@
 #pragma once
 
 #include <cassert>
+#include <cstring>
+#include <algorithm>
 #include <vector>
+#include <map>
+#include <unordered_map>
+#include <memory>
+#include <memory_resource>
 #include <span>
 #include <string>
+#include <string_view>
+#include <variant>
+#include <bit>
 
 #include <DaiSer/Config.h>
 
+#include <DaiSer/Utility/VarInt.hpp>
+#include <DaiSer/Utility/Reflection.hpp>
+#include <DaiSer/Utility/ByteSwap.hpp>
+
 #include "FieldID.h"
+#include "OutputSink.h"
+#include "MappedFile.h"
+#include "Checksum.h"
+#include "Utf8.h"
+#include "StringTable.h"
+#include "ParallelFor.h"
 
 /// This header just contains pure serialization, where it applies template specialization 
 /// to handle different types.
@@ -20,69 +39,324 @@ namespace DaiSer
 		Read,	// Copies bytes from buffer onto type
 	};
 
+	/// Integers that are written as varints (zigzagged if signed) when DAISER_COMPACT_ENCODING is enabled,
+	/// this includes the length prefixes of containers since they are std::uint64_t.
+	/// 
+	template<typename T>
+	concept CompactInteger = bool(DAISER_COMPACT_ENCODING) && std::is_integral_v<T> && !std::is_same_v<T, bool> && (sizeof(T) > 1);
+
+	/// Byte order of scalars on the wire, machines with another native byte order swap when reading and writing
+	/// 
+	inline constexpr std::endian WIRE_ENDIAN = DAISER_WIRE_BIG_ENDIAN ? std::endian::big : std::endian::little;
+
+	/// Trivially copyable types whose bytes are reordered on this machine to match the wire byte order
+	/// 
+	template<typename T>
+	concept WireSwapped = (WIRE_ENDIAN != std::endian::native) && std::is_trivially_copyable_v<T> && !CompactInteger<T> && HasByteOrder<T>();
+
+	template<typename Tuple>
+	constexpr std::size_t SumFixedSizes();
+
+	template<typename T>
+	struct SerializeImpl;
+
+	/// Types that can report the exact number of bytes they will be written as before writing them
+	/// 
+	template<typename T>
+	concept Measurable = requires(const T& aInData)
+	{
+		{ SerializeImpl<T>{}.Size(aInData) } -> std::convertible_to<std::size_t>;
+	};
+
+	/// Whether every member of the tied aggregate is Measurable, so that the aggregate is as well
+	/// 
+	template<typename Tuple>
+	inline constexpr bool MEASURABLE_MEMBERS = false;
+
+	template<typename... Ts>
+	inline constexpr bool MEASURABLE_MEMBERS<std::tuple<Ts...>> = (Measurable<std::remove_cvref_t<Ts>> && ...);
+
 	template<typename T>
 	struct SerializeImpl
 	{
-		NODISC std::size_t Write(const T& aInData, std::vector<std::byte>& aOutBytes, std::size_t aOffset)
+		/// Whether the bytes of the type are copied as-is, specializations do not define this
+		/// 
+		static constexpr bool IS_RAW = std::is_trivially_copyable_v<T> && !CompactInteger<T> && !WireSwapped<T>;
+
+		/// Number of bytes that every value is written as, zero if it depends on the value
+		/// 
+		static constexpr std::size_t FIXED_SIZE = []
+		{
+			if constexpr (IS_RAW)
+				return sizeof(T);
+			else if constexpr (!std::is_trivially_copyable_v<T> && ReflectableAggregate<T>)
+				return SumFixedSizes<MemberTypes<T>>();
+			else
+				return std::size_t(0);
+		}();
+
+		/// Returns the exact number of bytes that Write will produce
+		/// 
+		NODISC constexpr std::size_t Size(const T& aInData) const
+			requires (std::is_trivially_copyable_v<T>);
+
+		NODISC constexpr std::size_t Size(const T& aInData) const
+			requires (!std::is_trivially_copyable_v<T> && ReflectableAggregate<T> && MEASURABLE_MEMBERS<MemberTypes<T>>);
+
+		template<ByteSink Sink>
+		NODISC std::size_t Write(const T& aInData, Sink& aOutSink, std::size_t aOffset)
 			requires (std::is_trivially_copyable_v<T>); // trivially copyable is required to prevent UB
 
-		NODISC std::size_t Read(T& aOutData, const std::vector<std::byte>& aInBytes, std::size_t aOffset)
+		NODISC std::size_t Read(T& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset)
 			requires (std::is_trivially_copyable_v<T>); // trivially copyable is required to prevent UB
+
+		/// Aggregates that are not trivially copyable are serialized member by member, where runs of adjacent 
+		/// raw members without padding between them are copied with a single memcpy
+		/// 
+		template<ByteSink Sink>
+		NODISC std::size_t Write(const T& aInData, Sink& aOutSink, std::size_t aOffset)
+			requires (!std::is_trivially_copyable_v<T> && ReflectableAggregate<T>);
+
+		NODISC std::size_t Read(T& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset)
+			requires (!std::is_trivially_copyable_v<T> && ReflectableAggregate<T>);
 	};
 
+	template<typename T>
+	concept RawSerializable = requires { requires SerializeImpl<T>::IS_RAW; };
+
+	/// Number of bytes that every value of the type is written as, zero if it depends on the value
+	/// 
+	template<typename T>
+	inline constexpr std::size_t FixedSizeOf = []
+	{
+		if constexpr (requires { SerializeImpl<T>::FIXED_SIZE; })
+			return SerializeImpl<T>::FIXED_SIZE;
+		else
+			return std::size_t(0);
+	}();
+
+	/// Container lengths are always written as std::uint64_t so that 32 and 64-bit builds can share buffers
+	/// 
+	NODISC constexpr std::size_t LengthSize(std::size_t aLength);
+
+	template<ByteSink Sink>
+	NODISC std::size_t WriteLength(std::size_t aLength, Sink& aOutSink, std::size_t aOffset);
+
+	NODISC std::size_t ReadLength(std::size_t& aOutLength, std::span<const std::byte> aInBytes, std::size_t aOffset);
+
+	/// Strings are written as the number of characters followed by the characters, where the number is always 
+	/// a varint since most strings are short enough for a single byte
+	/// 
+	NODISC constexpr std::size_t StringLengthSize(std::size_t aLength);
+
+	NODISC std::size_t ReadStringLength(std::size_t& aOutLength, std::span<const std::byte> aInBytes, std::size_t aOffset);
+
+	/// Strings of the character type are written as UTF-8, which then is the character that the length counts
+	/// 
+	template<typename CharT>
+	inline constexpr bool IS_UTF8_ON_WIRE = DAISER_UTF8_WSTRING && std::is_same_v<CharT, wchar_t>;
+
+	/// Shared by all string types, the characters are read with a single copy into the existing capacity
+	/// 
+	template<typename CharT>
+	NODISC constexpr std::size_t StringSize(std::basic_string_view<CharT> aInData);
+
+	template<typename CharT, ByteSink Sink>
+	NODISC std::size_t WriteString(std::basic_string_view<CharT> aInData, Sink& aOutSink, std::size_t aOffset);
+
+	template<typename String>
+	NODISC std::size_t ReadString(String& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset);
+
+	/// While a StringTable is active, char strings start with a varint header instead of the length. An even 
+	/// header is the length shifted by one and is followed by the characters, an odd header is the index of 
+	/// an earlier string in the table shifted by one. Size always measures the plain format, so everything 
+	/// that writes into measured space turns the table off.
+	/// 
+	template<ByteSink Sink>
+	NODISC std::size_t WriteTableString(std::string_view aInData, StringTable& aTable, Sink& aOutSink, std::size_t aOffset);
+
+	NODISC DAISER_API std::size_t ReadTableString(std::string_view& aOutData, StringTable& aTable, std::span<const std::byte> aInBytes, std::size_t aOffset);
+
+	/// Vectors of non-trivial elements with at least DAISER_PARALLEL_THRESHOLD elements are written as chunks 
+	/// of PARALLEL_CHUNK_SIZE elements, preceded by the byte size of every chunk, so that the chunks can be 
+	/// encoded and decoded on separate threads. While a string table is set the elements are written one 
+	/// after another instead, since the table has to see the strings in order.
+	/// 
+	inline constexpr std::size_t PARALLEL_CHUNK_SIZE = 4096;
+
+	/// Elements whose vectors may be chunked, chunks are measured before they are written
+	/// 
+	template<typename T>
+	concept ChunkableElement = (DAISER_PARALLEL_THRESHOLD != 0) && !std::is_trivially_copyable_v<T> && Measurable<T>;
+
+	/// Whether a vector of aNumElements elements is written as chunks, which depends on the string table
+	/// that is active on this thread, so writer and reader must both have a table set or neither
+	/// 
+	template<typename T>
+	NODISC bool IsChunkedLayout(std::size_t aNumElements);
+
 	template<>
 	struct DAISER_API SerializeImpl<std::string>
 	{
-		NODISC std::size_t Write(const std::string& aInData, std::vector<std::byte>& aOutBytes, std::size_t aOffset);
+		NODISC constexpr std::size_t Size(const std::string& aInData) const noexcept;
 
-		NODISC std::size_t Read(std::string& aOutData, const std::vector<std::byte>& aInBytes, std::size_t aOffset);
+		template<ByteSink Sink>
+		NODISC std::size_t Write(const std::string& aInData, Sink& aOutSink, std::size_t aOffset);
+
+		NODISC std::size_t Read(std::string& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset);
 	};
 
 	template<>
 	struct DAISER_API SerializeImpl<std::wstring>
 	{
-		NODISC std::size_t Write(const std::wstring& aInData, std::vector<std::byte>& aOutBytes, std::size_t aOffset);
+		NODISC std::size_t Size(const std::wstring& aInData) const noexcept;
+
+		template<ByteSink Sink>
+		NODISC std::size_t Write(const std::wstring& aInData, Sink& aOutSink, std::size_t aOffset);
 
-		NODISC std::size_t Read(std::wstring& aOutData, const std::vector<std::byte>& aInBytes, std::size_t aOffset);
+		NODISC std::size_t Read(std::wstring& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset);
 	};
 
-	template<typename T>
-	struct SerializeImpl<std::vector<T>>
+	/// Reads a view that points straight into the source buffer, the buffer must outlive the view
+	/// 
+	template<>
+	struct DAISER_API SerializeImpl<std::string_view>
 	{
-		NODISC std::size_t Write(const std::vector<T>& aInData, std::vector<std::byte>& aOutBytes, std::size_t aOffset)
+		NODISC constexpr std::size_t Size(std::string_view aInData) const noexcept;
+
+		template<ByteSink Sink>
+		NODISC std::size_t Write(std::string_view aInData, Sink& aOutSink, std::size_t aOffset);
+
+		NODISC std::size_t Read(std::string_view& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset);
+	};
+
+	/// Strings with other character types or allocators, e.g., std::pmr::string, same wire format as std::string
+	/// 
+	template<typename CharT, typename Traits, typename Alloc>
+	struct SerializeImpl<std::basic_string<CharT, Traits, Alloc>>
+	{
+		NODISC constexpr std::size_t Size(const std::basic_string<CharT, Traits, Alloc>& aInData) const noexcept;
+
+		template<ByteSink Sink>
+		NODISC std::size_t Write(const std::basic_string<CharT, Traits, Alloc>& aInData, Sink& aOutSink, std::size_t aOffset);
+
+		NODISC std::size_t Read(std::basic_string<CharT, Traits, Alloc>& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset);
+	};
+
+	template<typename T, typename Alloc>
+	struct SerializeImpl<std::vector<T, Alloc>>
+	{
+		NODISC constexpr std::size_t Size(const std::vector<T, Alloc>& aInData) const
+			requires (Measurable<T>);
+
+		template<ByteSink Sink>
+		NODISC std::size_t Write(const std::vector<T, Alloc>& aInData, Sink& aOutSink, std::size_t aOffset)
 			requires (std::is_trivially_copyable_v<T>);
 
-		NODISC std::size_t Read(std::vector<T>& aOutData, const std::vector<std::byte>& aInBytes, std::size_t aOffset)
+		NODISC std::size_t Read(std::vector<T, Alloc>& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset)
 			requires (std::is_trivially_copyable_v<T>);
 
-		NODISC std::size_t Write(const std::vector<T>& aInData, std::vector<std::byte>& aOutBytes, std::size_t aOffset)
+		template<ByteSink Sink>
+		NODISC std::size_t Write(const std::vector<T, Alloc>& aInData, Sink& aOutSink, std::size_t aOffset)
 			requires (!std::is_trivially_copyable_v<T>); // user must provide their own custom specialization for this type to work
 
-		NODISC std::size_t Read(std::vector<T>& aOutData, const std::vector<std::byte>& aInBytes, std::size_t aOffset)
+		NODISC std::size_t Read(std::vector<T, Alloc>& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset)
 			requires (!std::is_trivially_copyable_v<T>);
+
+	private:
+		template<ByteSink Sink>
+		NODISC std::size_t WriteChunks(const std::vector<T, Alloc>& aInData, Sink& aOutSink, std::size_t aOffset);
+
+		NODISC std::size_t ReadChunks(std::vector<T, Alloc>& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset);
 	};
 
-	template<typename T, typename U> requires (!std::is_trivially_copyable_v<T> || !std::is_trivially_copyable_v<U>)
+	/// Same wire format as std::vector<T>, but reads a view that points straight into the source 
+	/// buffer. The buffer must outlive the view and the elements must be suitably aligned in it.
+	/// 
+	template<typename T> requires (std::is_trivially_copyable_v<T>)
+	struct SerializeImpl<std::span<const T>>
+	{
+		NODISC constexpr std::size_t Size(std::span<const T> aInData) const;
+
+		template<ByteSink Sink>
+		NODISC std::size_t Write(std::span<const T> aInData, Sink& aOutSink, std::size_t aOffset);
+
+		NODISC std::size_t Read(std::span<const T>& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset)
+			requires (RawSerializable<T>); // compact integers and swapped types are not stored as-is and can therefore not be viewed
+	};
+
+	/// Written as the number of entries followed by each key and value, entries are read with the 
+	/// allocator of the map so that std::pmr maps keep all of their memory in the same resource.
+	/// 
+	template<typename Map>
+	struct SerializeMapImpl
+	{
+		using Key	= typename Map::key_type;
+		using Value	= typename Map::mapped_type;
+
+		NODISC constexpr std::size_t Size(const Map& aInData) const
+			requires (Measurable<Key> && Measurable<Value>);
+
+		template<ByteSink Sink>
+		NODISC std::size_t Write(const Map& aInData, Sink& aOutSink, std::size_t aOffset);
+
+		NODISC std::size_t Read(Map& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset);
+	};
+
+	template<typename Key, typename Value, typename Compare, typename Alloc>
+	struct SerializeImpl<std::map<Key, Value, Compare, Alloc>> : SerializeMapImpl<std::map<Key, Value, Compare, Alloc>> {};
+
+	template<typename Key, typename Value, typename Hash, typename Equal, typename Alloc>
+	struct SerializeImpl<std::unordered_map<Key, Value, Hash, Equal, Alloc>> : SerializeMapImpl<std::unordered_map<Key, Value, Hash, Equal, Alloc>> {};
+
+	/// Reads the length prefix and locates the raw elements of a trivially copyable array without copying them
+	/// 
+	template<RawSerializable T>
+	std::size_t ReadElements(std::span<const T>& aOutElements, std::span<const std::byte> aInBytes, std::size_t aOffset);
+
+	/// Writes the tied members of an aggregate, returns the offset after the last member
+	/// 
+	template<std::size_t I = 0, typename Tuple, ByteSink Sink>
+	std::size_t WriteMembers(const Tuple& aMembers, Sink& aOutSink, std::size_t aOffset, const std::byte* aRunBegin = nullptr, std::size_t aRunSize = 0);
+
+	/// Reads the tied members of an aggregate, returns the offset after the last member
+	/// 
+	template<std::size_t I = 0, typename Tuple>
+	std::size_t ReadMembers(const Tuple& aMembers, std::span<const std::byte> aInBytes, std::size_t aOffset, std::byte* aRunBegin = nullptr, std::size_t aRunSize = 0);
+
+	template<typename T, typename U> requires (!std::is_trivially_copyable_v<std::pair<T, U>>)
 	struct SerializeImpl<std::pair<T, U>>
 	{
-		NODISC std::size_t Write(const std::pair<T, U>& aInData, std::vector<std::byte>& aOutBytes, std::size_t aOffset);
+		static constexpr std::size_t FIXED_SIZE = (FixedSizeOf<T> != 0 && FixedSizeOf<U> != 0) ? FixedSizeOf<T> + FixedSizeOf<U> : 0;
+
+		NODISC constexpr std::size_t Size(const std::pair<T, U>& aInData) const
+			requires (Measurable<T> && Measurable<U>);
 
-		NODISC std::size_t Read(std::pair<T, U>& aOutData, const std::vector<std::byte>& aInBytes, std::size_t aOffset);
+		template<ByteSink Sink>
+		NODISC std::size_t Write(const std::pair<T, U>& aInData, Sink& aOutSink, std::size_t aOffset);
+
+		NODISC std::size_t Read(std::pair<T, U>& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset);
 	};
 
-	template<typename... Ts> requires (!std::is_trivially_copyable_v<Ts> || ...)
+	template<typename... Ts> requires (!std::is_trivially_copyable_v<std::tuple<Ts...>>)
 	struct SerializeImpl<std::tuple<Ts...>>
 	{
-		NODISC std::size_t Write(const std::tuple<Ts...>& aInData, std::vector<std::byte>& aOutBytes, std::size_t aOffset);
+		static constexpr std::size_t FIXED_SIZE = ((FixedSizeOf<Ts> != 0) && ...) ? (FixedSizeOf<Ts> + ...) : 0;
+
+		NODISC constexpr std::size_t Size(const std::tuple<Ts...>& aInData) const
+			requires (Measurable<Ts> && ...);
 
-		NODISC std::size_t Read(std::tuple<Ts...>& aOutData, const std::vector<std::byte>& aInBytes, std::size_t aOffset);
+		template<ByteSink Sink>
+		NODISC std::size_t Write(const std::tuple<Ts...>& aInData, Sink& aOutSink, std::size_t aOffset);
+
+		NODISC std::size_t Read(std::tuple<Ts...>& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset);
 
 	private:
-		template<std::size_t I = 0>
-		std::size_t WriteTuple(const std::tuple<Ts...>& aInData, std::vector<std::byte>& aOutBytes, std::size_t aOffset);
+		template<std::size_t I = 0, ByteSink Sink>
+		std::size_t WriteTuple(const std::tuple<Ts...>& aInData, Sink& aOutSink, std::size_t aOffset);
 
 		template<std::size_t I = 0>
-		std::size_t ReadTuple(std::tuple<Ts...>& aOutData, const std::vector<std::byte>& aInBytes, std::size_t aOffset);
+		std::size_t ReadTuple(std::tuple<Ts...>& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset);
 	};
 
 	class Serializer
@@ -97,9 +371,8 @@ namespace DaiSer
 	protected:
 		DAISER_API Serializer(SerializerState aState);
 
-		SerializerState			myState;
-		std::vector<std::byte>	myBuffer;
-		std::size_t				myOffset;
+		SerializerState	myState;
+		std::size_t		myOffset;
 	};
 
 	/// Serialize variables to buffer
@@ -109,19 +382,54 @@ namespace DaiSer
 	public:
 		DAISER_API WriteSerializer();
 
+		/// Writes into the given buffer, e.g., one from BufferPool, its contents are discarded but its capacity is kept
+		/// 
+		DAISER_API explicit WriteSerializer(ByteBuffer&& aBuffer);
+
 		template<typename T>
 		void Serialize(const T& aInData);
 
-		NODISC std::vector<std::byte>&& MoveBuffer() { return std::move(myBuffer); }
+		/// Serializes without any capacity checks, ReserveBytesToFit must have been called 
+		/// beforehand with enough bytes to fit the data.
+		/// 
+		template<typename T>
+		void SerializeUnchecked(const T& aInData);
+
+		/// Measures the data first, allocates once to fit all of it, and then writes it without any 
+		/// capacity checks.
+		/// 
+		template<typename... Ts> requires (Measurable<std::decay_t<Ts>> && ...)
+		void SerializeExact(const Ts&... aInData);
 
-		NODISC std::span<const std::byte> GetBuffer() const noexcept { return myBuffer; }
-		NODISC const std::byte* GetBufferData() const noexcept { return myBuffer.data(); }
+		NODISC DAISER_API ByteBuffer MoveBuffer();
 
+		NODISC std::span<const std::byte> GetBuffer() const noexcept { return { myBuffer.GetData(), myOffset }; }
+		NODISC const std::byte* GetBufferData() const noexcept { return myBuffer.GetData(); }
+
+		/// Pre-allocates memory to fit the number of bytes after the current offset, does not
+		/// change the size of the buffer.
+		/// 
 		DAISER_API void ReserveBytesToFit(std::size_t aNumBytesToFit);
 
 		DAISER_API void FitBufferToOffset();
 
+		/// Writes the CRC32C of everything serialized so far as a trailer, call once after the last value
+		/// 
+		DAISER_API void AppendChecksum();
+
 		DAISER_API void Clear();
+
+		/// Writes repeated strings as indices into the table, see StringTable, nullptr turns it off. The 
+		/// table is not owned and keeps its entries between messages until it is cleared. Vectors are not 
+		/// chunked for parallel encoding while a table is set.
+		/// 
+		void SetStringTable(StringTable* aTable) noexcept { myStringTable = aTable; }
+
+	private:
+		ByteBuffer myBuffer;
+		StringTable* myStringTable = nullptr;
+
+		friend class ODSStream;
 	};
 
 	/// Deserialize buffer to variables
@@ -129,120 +437,411 @@ namespace DaiSer
 	class ReadSerializer : protected Serializer
 	{
 	public:
+		/// Takes ownership of the buffer
+		/// 
+		DAISER_API ReadSerializer(ByteBuffer&& aBuffer);
 		DAISER_API ReadSerializer(std::vector<std::byte>&& aBuffer);
+
+		/// Decodes straight from the mapped file, pages are loaded as they are read
+		/// 
+		DAISER_API ReadSerializer(MappedFile&& aFile);
+
+		/// Borrows the buffer without copying it, the memory must outlive the serializer and 
+		/// any views (std::string_view, std::span) read from it.
+		/// 
 		DAISER_API ReadSerializer(std::span<const std::byte> aBuffer);
 
+		ReadSerializer(const ReadSerializer&) = delete;
+		ReadSerializer& operator=(const ReadSerializer&) = delete;
+
+		DAISER_API ReadSerializer(ReadSerializer&& aOther) noexcept;
+		DAISER_API ReadSerializer& operator=(ReadSerializer&& aOther) noexcept;
+
 		template<typename T>
-		void Deserialize(T& aOutData) const;
+		void Deserialize(T& aOutData);
+
+		/// Constructs the value with the memory resource and deserializes into it, allocator-aware types 
+		/// such as std::pmr containers then allocate all of their nested memory from the resource.
+		/// 
+		template<typename T>
+		NODISC T Deserialize(std::pmr::memory_resource* aResource);
+
+		NODISC std::span<const std::byte> GetBuffer() const noexcept { return myBuffer; }
+		NODISC std::size_t GetRemaining() const noexcept { return myBuffer.size() - myOffset; }
+
+		NODISC DAISER_API bool IsDone() const;
+
+		/// Checks the trailer written by WriteSerializer::AppendChecksum against the rest of the buffer in a 
+		/// single pass and excludes it from the bytes to read. Call before reading, throws std::runtime_error 
+		/// if the buffer is truncated or corrupted.
+		/// 
+		DAISER_API void VerifyChecksum();
+
+		/// Reads strings written with a string table, the table must start out the same as the one of the 
+		/// writer did, e.g., empty. Views read from the serializer may then point into the table.
+		/// 
+		void SetStringTable(StringTable* aTable) noexcept { myStringTable = aTable; }
 
-		bool IsDone() const;
+	private:
+		std::variant<std::monostate, ByteBuffer, std::vector<std::byte>, MappedFile> myStorage;
+		std::span<const std::byte> myBuffer;
+		StringTable* myStringTable = nullptr;
+
+		friend class IDSStream;
 	};
 
 	template<typename T>
 	inline void WriteSerializer::Serialize(const T& aInData)
 	{
-		myOffset += SerializeImpl<std::decay_t<T>>{}.Write(aInData, myBuffer, myOffset);
+		if (myStringTable != nullptr)
+		{
+			StringTableScope scope(myStringTable);
+			myOffset += SerializeImpl<std::decay_t<T>>{}.Write(aInData, myBuffer, myOffset);
+		}
+		else
+		{
+			myOffset += SerializeImpl<std::decay_t<T>>{}.Write(aInData, myBuffer, myOffset);
+		}
 	}
 
 	template<typename T>
-	inline void ReadSerializer::Deserialize(T& aOutData) const
+	inline void WriteSerializer::SerializeUnchecked(const T& aInData)
+	{
+		assert(myStringTable == nullptr && "Strings written with a table cannot be measured beforehand!");
+
+		UncheckedSink sink(myBuffer.GetData(), myBuffer.GetCapacity());
+		myOffset += SerializeImpl<std::decay_t<T>>{}.Write(aInData, sink, myOffset);
+		myBuffer.Commit(myOffset);
+	}
+
+	template<typename... Ts> requires (Measurable<std::decay_t<Ts>> && ...)
+	inline void WriteSerializer::SerializeExact(const Ts&... aInData)
 	{
-		myOffset += SerializeImpl<std::decay_t<T>>{}.Read(aOutData, myBuffer, myOffset);
+		assert(myStringTable == nullptr && "Strings written with a table cannot be measured beforehand!");
+
+		const std::size_t numBytes = (SerializeImpl<std::decay_t<Ts>>{}.Size(aInData) + ... + 0);
+
+		UncheckedSink sink(myBuffer.Prepare(myOffset, numBytes), numBytes, myOffset);
+		((myOffset += SerializeImpl<std::decay_t<Ts>>{}.Write(aInData, sink, myOffset)), ...);
 	}
 
 	template<typename T>
-	inline std::size_t SerializeImpl<T>::Write(const T& aInData, std::vector<std::byte>& aOutBytes, std::size_t aOffset)
-		requires (std::is_trivially_copyable_v<T>)
+	inline void ReadSerializer::Deserialize(T& aOutData)
+	{
+		if (myStringTable != nullptr)
+		{
+			StringTableScope scope(myStringTable);
+			myOffset += SerializeImpl<std::decay_t<T>>{}.Read(aOutData, myBuffer, myOffset);
+		}
+		else
+		{
+			myOffset += SerializeImpl<std::decay_t<T>>{}.Read(aOutData, myBuffer, myOffset);
+		}
+	}
+
+	inline constexpr std::size_t LengthSize(std::size_t aLength)
+	{
+		return SerializeImpl<std::uint64_t>{}.Size(static_cast<std::uint64_t>(aLength));
+	}
+
+	template<ByteSink Sink>
+	inline std::size_t WriteLength(std::size_t aLength, Sink& aOutSink, std::size_t aOffset)
+	{
+		return SerializeImpl<std::uint64_t>{}.Write(static_cast<std::uint64_t>(aLength), aOutSink, aOffset);
+	}
+
+	inline std::size_t ReadLength(std::size_t& aOutLength, std::span<const std::byte> aInBytes, std::size_t aOffset)
 	{
-		static constexpr std::size_t numBytes = sizeof(T);
+		std::uint64_t length = 0;
+		const std::size_t numBytes = SerializeImpl<std::uint64_t>{}.Read(length, aInBytes, aOffset);
 
-		aOutBytes.resize(aOffset + numBytes);
-		memcpy_s(aOutBytes.data() + aOffset, numBytes, &aInData, numBytes);
+		assert(length <= SIZE_MAX && "Length does not fit on this machine!");
+		aOutLength = static_cast<std::size_t>(length);
 
 		return numBytes;
 	}
 
-	template<typename T>
-	inline std::size_t SerializeImpl<T>::Read(T& aOutData, const std::vector<std::byte>& aInBytes, std::size_t aOffset)
-		requires (std::is_trivially_copyable_v<T>)
+	inline constexpr std::size_t StringLengthSize(std::size_t aLength)
 	{
-		static constexpr std::size_t numBytes = sizeof(T);
+		return VarIntSize(static_cast<std::uint64_t>(aLength));
+	}
 
-		assert((aOffset + numBytes) <= aInBytes.size() && "Not enough memory to read from!");
-		memcpy_s(&aOutData, numBytes, aInBytes.data() + aOffset, numBytes);
+	inline std::size_t ReadStringLength(std::size_t& aOutLength, std::span<const std::byte> aInBytes, std::size_t aOffset)
+	{
+		assert(aOffset <= aInBytes.size() && "Not enough memory to read from!");
+
+		std::uint64_t length = 0;
+		const std::size_t numBytes = DecodeVarInt(aInBytes.data() + aOffset, aInBytes.size() - aOffset, length);
+
+		assert(numBytes != 0 && "Malformed or truncated varint!");
+		assert(length <= SIZE_MAX && "Length does not fit on this machine!");
+
+		aOutLength = static_cast<std::size_t>(length);
 
 		return numBytes;
 	}
 
 	template<typename T>
-	inline std::size_t SerializeImpl<std::vector<T>>::Write(const std::vector<T>& aInData, std::vector<std::byte>& aOutBytes, std::size_t aOffset)
+	inline bool IsChunkedLayout(std::size_t aNumElements)
+	{
+		if constexpr (ChunkableElement<T>)
+			return aNumElements >= DAISER_PARALLEL_THRESHOLD && StringTable::GetActive() == nullptr;
+		else
+			return false;
+	}
+
+	template<typename T>
+	inline T ReadSerializer::Deserialize(std::pmr::memory_resource* aResource)
+	{
+		T result = std::make_obj_using_allocator<T>(std::pmr::polymorphic_allocator<>(aResource));
+		Deserialize(result);
+
+		return result;
+	}
+
+	template<typename Tuple>
+	inline constexpr std::size_t SumFixedSizes()
+	{
+		return []<std::size_t... Is>(std::index_sequence<Is...>)
+		{
+			using Types = std::tuple<std::remove_cvref_t<std::tuple_element_t<Is, Tuple>>...>;
+			return ((FixedSizeOf<std::tuple_element_t<Is, Types>> != 0) && ...) ? (FixedSizeOf<std::tuple_element_t<Is, Types>> + ... + 0) : 0;
+		}(std::make_index_sequence<std::tuple_size_v<Tuple>>{});
+	}
+
+	template<typename T>
+	inline constexpr std::size_t SerializeImpl<T>::Size(const T& aInData) const
 		requires (std::is_trivially_copyable_v<T>)
 	{
-		static constexpr std::size_t TYPE_SIZE = sizeof(T);
+		if constexpr (CompactInteger<T>)
+			return VarIntSize(ToVarIntValue(aInData));
+		else
+			return sizeof(T);
+	}
 
-		std::size_t numElements = aInData.size();
-		std::size_t numBytes	= TYPE_SIZE * numElements;
+	template<typename T>
+	inline constexpr std::size_t SerializeImpl<T>::Size(const T& aInData) const
+		requires (!std::is_trivially_copyable_v<T> && ReflectableAggregate<T> && MEASURABLE_MEMBERS<MemberTypes<T>>)
+	{
+		if constexpr (FIXED_SIZE != 0)
+		{
+			return FIXED_SIZE;
+		}
+		else
+		{
+			return std::apply([](const auto&... aMembers)
+			{
+				return (SerializeImpl<std::remove_cvref_t<decltype(aMembers)>>{}.Size(aMembers) + ...);
+			}, TieMembers(aInData));
+		}
+	}
 
-		aOutBytes.resize(aOffset + numBytes + sizeof(std::size_t));
+	template<typename T>
+	template<ByteSink Sink>
+	inline std::size_t SerializeImpl<T>::Write(const T& aInData, Sink& aOutSink, std::size_t aOffset)
+		requires (std::is_trivially_copyable_v<T>)
+	{
+		if constexpr (CompactInteger<T>)
+		{
+			const std::uint64_t value		= ToVarIntValue(aInData);
+			const std::size_t	numBytes	= VarIntSize(value);
 
-		memcpy_s(aOutBytes.data() + aOffset, sizeof(std::size_t), &numElements, sizeof(std::size_t));
+			EncodeVarInt(value, aOutSink.Prepare(aOffset, numBytes));
 
-		aOffset += sizeof(std::size_t);
+			return numBytes;
+		}
+		else if constexpr (WireSwapped<T>)
+		{
+			static constexpr std::size_t numBytes = sizeof(T);
+
+			T value = aInData;
+			SwapBytesInPlace(value);
+
+			std::memcpy(aOutSink.Prepare(aOffset, numBytes), &value, numBytes);
+
+			return numBytes;
+		}
+		else
+		{
+			static constexpr std::size_t numBytes = sizeof(T);
 
-		memcpy_s(aOutBytes.data() + aOffset, numBytes, aInData.data(), numBytes);
+			std::memcpy(aOutSink.Prepare(aOffset, numBytes), &aInData, numBytes);
 
-		return numBytes + sizeof(std::size_t);
+			return numBytes;
+		}
 	}
+
 	template<typename T>
-	inline std::size_t SerializeImpl<std::vector<T>>::Read(std::vector<T>& aOutData, const std::vector<std::byte>& aInBytes, std::size_t aOffset)
+	inline std::size_t SerializeImpl<T>::Read(T& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset)
 		requires (std::is_trivially_copyable_v<T>)
 	{
-		static constexpr std::size_t TYPE_SIZE = sizeof(T);
+		if constexpr (CompactInteger<T>)
+		{
+			assert(aOffset <= aInBytes.size() && "Not enough memory to read from!");
 
-		std::size_t numElements = 0;
-		memcpy_s(&numElements, sizeof(std::size_t), aOutData.data() + aOffset, sizeof(std::size_t));
+			std::uint64_t value = 0;
+			const std::size_t numBytes = DecodeVarInt(aInBytes.data() + aOffset, aInBytes.size() - aOffset, value);
 
-		std::size_t numBytes = TYPE_SIZE * numElements;
+			assert(numBytes != 0 && "Malformed or truncated varint!");
+			aOutData = FromVarIntValue<T>(value);
 
-		assert((aOffset + numBytes + sizeof(std::size_t)) <= aInBytes.size() && "Not enough memory to read from!");
-			
-		aOutData.resize(numElements);
+			return numBytes;
+		}
+		else
+		{
+			static constexpr std::size_t numBytes = sizeof(T);
 
-		aOffset += sizeof(std::size_t);
+			assert((aOffset + numBytes) <= aInBytes.size() && "Not enough memory to read from!");
+			std::memcpy(&aOutData, aInBytes.data() + aOffset, numBytes);
 
-		memcpy_s(aOutData.data(), numBytes, aInBytes.data() + aOffset, numBytes);
+			if constexpr (WireSwapped<T>)
+				SwapBytesInPlace(aOutData);
 
-		return numBytes + sizeof(std::size_t);
+			return numBytes;
+		}
+	}
+
+	template<typename T>
+	template<ByteSink Sink>
+	inline std::size_t SerializeImpl<T>::Write(const T& aInData, Sink& aOutSink, std::size_t aOffset)
+		requires (!std::is_trivially_copyable_v<T> && ReflectableAggregate<T>)
+	{
+		return WriteMembers(TieMembers(aInData), aOutSink, aOffset) - aOffset;
 	}
 
 	template<typename T>
-	inline std::size_t SerializeImpl<std::vector<T>>::Write(const std::vector<T>& aInData, std::vector<std::byte>& aOutBytes, std::size_t aOffset)
+	inline std::size_t SerializeImpl<T>::Read(T& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset)
+		requires (!std::is_trivially_copyable_v<T> && ReflectableAggregate<T>)
+	{
+		return ReadMembers(TieMembers(aOutData), aInBytes, aOffset) - aOffset;
+	}
+
+	template<typename T, typename Alloc>
+	inline constexpr std::size_t SerializeImpl<std::vector<T, Alloc>>::Size(const std::vector<T, Alloc>& aInData) const
+		requires (Measurable<T>)
+	{
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			return SerializeImpl<std::span<const T>>{}.Size(aInData);
+		}
+		else
+		{
+			std::size_t numBytes = LengthSize(aInData.size());
+
+			if (IsChunkedLayout<T>(aInData.size()))
+			{
+				for (std::size_t first = 0; first < aInData.size(); first += PARALLEL_CHUNK_SIZE)
+				{
+					std::size_t chunkBytes = 0;
+
+					const std::size_t last = std::min(first + PARALLEL_CHUNK_SIZE, aInData.size());
+					for (std::size_t i = first; i < last; ++i)
+						chunkBytes += SerializeImpl<T>{}.Size(aInData[i]);
+
+					numBytes += LengthSize(chunkBytes) + chunkBytes;
+				}
+			}
+			else if constexpr (FixedSizeOf<T> != 0)
+			{
+				numBytes += FixedSizeOf<T> * aInData.size();
+			}
+			else
+			{
+				for (const T& element : aInData)
+					numBytes += SerializeImpl<T>{}.Size(element);
+			}
+
+			return numBytes;
+		}
+	}
+
+	template<typename T, typename Alloc>
+	template<ByteSink Sink>
+	inline std::size_t SerializeImpl<std::vector<T, Alloc>>::Write(const std::vector<T, Alloc>& aInData, Sink& aOutSink, std::size_t aOffset)
+		requires (std::is_trivially_copyable_v<T>)
+	{
+		return SerializeImpl<std::span<const T>>{}.Write(aInData, aOutSink, aOffset);
+	}
+	template<typename T, typename Alloc>
+	inline std::size_t SerializeImpl<std::vector<T, Alloc>>::Read(std::vector<T, Alloc>& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset)
+		requires (std::is_trivially_copyable_v<T>)
+	{
+		if constexpr (CompactInteger<T>)
+		{
+			std::size_t numElements = 0;
+			std::size_t numBytes	= ReadLength(numElements, aInBytes, aOffset);
+
+			aOutData.resize(numElements);
+
+			for (std::size_t i = 0; i < numElements; ++i)
+			{
+				numBytes += SerializeImpl<T>{}.Read(aOutData[i], aInBytes, aOffset + numBytes);
+			}
+
+			return numBytes;
+		}
+		else if constexpr (WireSwapped<T>)
+		{
+			std::size_t numElements = 0;
+			const std::size_t prefixBytes = ReadLength(numElements, aInBytes, aOffset);
+
+			const std::size_t numElementBytes = sizeof(T) * numElements;
+
+			assert((aOffset + prefixBytes + numElementBytes) <= aInBytes.size() && "Not enough memory to read from!");
+
+			aOutData.resize(numElements);
+			SwapBytesElements<T>(reinterpret_cast<std::byte*>(aOutData.data()), aInBytes.data() + aOffset + prefixBytes, numElements);
+
+			return prefixBytes + numElementBytes;
+		}
+		else
+		{
+			std::span<const T> elements;
+			const std::size_t numBytes = ReadElements(elements, aInBytes, aOffset);
+
+			aOutData.assign(elements.begin(), elements.end());
+
+			return numBytes;
+		}
+	}
+
+	template<typename T, typename Alloc>
+	template<ByteSink Sink>
+	inline std::size_t SerializeImpl<std::vector<T, Alloc>>::Write(const std::vector<T, Alloc>& aInData, Sink& aOutSink, std::size_t aOffset)
 		requires (!std::is_trivially_copyable_v<T>)
 	{
-		aOutBytes.resize(aOffset + sizeof(std::size_t));
+		const std::size_t numElements = aInData.size();
 
-		std::size_t numElements = aInOutData.size();
-		memcpy_s(aInOutBytes.data() + aOffset, sizeof(std::size_t), &numElements, sizeof(std::size_t));
+		std::size_t numBytes = WriteLength(numElements, aOutSink, aOffset);
 
-		std::size_t numBytes = sizeof(std::size_t);
+		if constexpr (ChunkableElement<T>)
+		{
+			if (IsChunkedLayout<T>(numElements))
+				return numBytes + WriteChunks(aInData, aOutSink, aOffset + numBytes);
+		}
 
 		for (std::size_t i = 0; i < numElements; ++i)
 		{
-			numBytes += SerializeImpl<T>{}.Write(aInOutData[i], aOutBytes, aOffset + numBytes);
+			numBytes += SerializeImpl<T>{}.Write(aInData[i], aOutSink, aOffset + numBytes);
 		}
 
 		return numBytes;
 	}
-	template<typename T>
-	inline std::size_t SerializeImpl<std::vector<T>>::Read(std::vector<T>& aOutData, const std::vector<std::byte>& aInBytes, std::size_t aOffset)
+
+	template<typename T, typename Alloc>
+	inline std::size_t SerializeImpl<std::vector<T, Alloc>>::Read(std::vector<T, Alloc>& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset)
 		requires (!std::is_trivially_copyable_v<T>)
 	{
 		std::size_t numElements = 0;
-		memcpy_s(&numElements, sizeof(std::size_t), aInBytes.data() + aOffset, sizeof(std::size_t));
+		std::size_t numBytes	= ReadLength(numElements, aInBytes, aOffset);
 
 		aOutData.resize(numElements);
 
-		std::size_t numBytes = sizeof(std::size_t);
+		if constexpr (ChunkableElement<T>)
+		{
+			if (IsChunkedLayout<T>(numElements))
+				return numBytes + ReadChunks(aOutData, aInBytes, aOffset + numBytes);
+		}
 
 		for (std::size_t i = 0; i < numElements; ++i)
 		{
@@ -252,21 +851,238 @@ namespace DaiSer
 		return numBytes;
 	}
 
-	template<typename T, typename U> requires (!std::is_trivially_copyable_v<T> || !std::is_trivially_copyable_v<U>)
-	inline std::size_t SerializeImpl<std::pair<T, U>>::Write(const std::pair<T, U>& aInData, std::vector<std::byte>& aOutBytes, std::size_t aOffset)
+	template<typename T, typename Alloc>
+	template<ByteSink Sink>
+	inline std::size_t SerializeImpl<std::vector<T, Alloc>>::WriteChunks(const std::vector<T, Alloc>& aInData, Sink& aOutSink, std::size_t aOffset)
+	{
+		const std::size_t numElements	= aInData.size();
+		const std::size_t numChunks		= (numElements + PARALLEL_CHUNK_SIZE - 1) / PARALLEL_CHUNK_SIZE;
+
+		std::vector<std::size_t> chunkBytes(numChunks);
+
+		ParallelFor(numChunks, [&](std::size_t aChunk)
+		{
+			const std::size_t first = aChunk * PARALLEL_CHUNK_SIZE;
+			const std::size_t last	= std::min(first + PARALLEL_CHUNK_SIZE, numElements);
+
+			for (std::size_t i = first; i < last; ++i)
+				chunkBytes[aChunk] += SerializeImpl<T>{}.Size(aInData[i]);
+		});
+
+		std::size_t tableBytes		= 0;
+		std::size_t payloadBytes	= 0;
+
+		for (const std::size_t numBytes : chunkBytes)
+		{
+			tableBytes		+= LengthSize(numBytes);
+			payloadBytes	+= numBytes;
+		}
+
+		if constexpr (!WindowedSink<Sink>)
+			(void)aOutSink.Prepare(aOffset, tableBytes + payloadBytes); // a single reservation for the table and every chunk
+
+		UncheckedSink tableSink(aOutSink.Prepare(aOffset, tableBytes), tableBytes, aOffset);
+
+		std::vector<std::size_t> chunkOffsets(numChunks);
+
+		std::size_t tableOffset = aOffset;
+		std::size_t chunkOffset = aOffset + tableBytes;
+
+		for (std::size_t i = 0; i < numChunks; ++i)
+		{
+			tableOffset += WriteLength(chunkBytes[i], tableSink, tableOffset);
+
+			chunkOffsets[i] = chunkOffset;
+			chunkOffset += chunkBytes[i];
+		}
+
+		// every chunk goes straight into its own part of the prepared memory, which for windowed sinks is done
+		// for as many chunks as fit the window at once
+		const std::size_t maxGroupBytes = MaxPrepareSize(aOutSink);
+
+		for (std::size_t firstChunk = 0, lastChunk = 0; firstChunk < numChunks; firstChunk = lastChunk)
+		{
+			std::size_t groupBytes = chunkBytes[firstChunk];
+
+			for (lastChunk = firstChunk + 1; lastChunk < numChunks && groupBytes + chunkBytes[lastChunk] <= maxGroupBytes; ++lastChunk)
+				groupBytes += chunkBytes[lastChunk];
+
+			std::byte* data = aOutSink.Prepare(chunkOffsets[firstChunk], groupBytes);
+
+			ParallelFor(lastChunk - firstChunk, [&](std::size_t aIndex)
+			{
+				const std::size_t chunk = firstChunk + aIndex;
+				const std::size_t first = chunk * PARALLEL_CHUNK_SIZE;
+				const std::size_t last	= std::min(first + PARALLEL_CHUNK_SIZE, numElements);
+
+				UncheckedSink chunkSink(data + (chunkOffsets[chunk] - chunkOffsets[firstChunk]), chunkBytes[chunk], chunkOffsets[chunk]);
+
+				std::size_t offset = chunkOffsets[chunk];
+				for (std::size_t i = first; i < last; ++i)
+					offset += SerializeImpl<T>{}.Write(aInData[i], chunkSink, offset);
+
+				assert(offset == chunkOffsets[chunk] + chunkBytes[chunk] && "Size does not match the written bytes!");
+			});
+		}
+
+		return tableBytes + payloadBytes;
+	}
+
+	template<typename T, typename Alloc>
+	inline std::size_t SerializeImpl<std::vector<T, Alloc>>::ReadChunks(std::vector<T, Alloc>& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset)
+	{
+		const std::size_t numElements	= aOutData.size();
+		const std::size_t numChunks		= (numElements + PARALLEL_CHUNK_SIZE - 1) / PARALLEL_CHUNK_SIZE;
+
+		std::vector<std::size_t> chunkOffsets(numChunks + 1);
+
+		std::size_t tableOffset = aOffset;
+		std::size_t chunkOffset = 0;
+
+		for (std::size_t i = 0; i < numChunks; ++i)
+		{
+			std::size_t chunkBytes = 0;
+			tableOffset += ReadLength(chunkBytes, aInBytes, tableOffset);
+
+			chunkOffsets[i] = chunkOffset;
+			chunkOffset += chunkBytes;
+		}
+
+		chunkOffsets[numChunks] = chunkOffset;
+
+		for (std::size_t& offset : chunkOffsets)
+			offset += tableOffset;
+
+		assert(chunkOffsets[numChunks] <= aInBytes.size() && "Not enough memory to read from!");
+
+		const auto ReadChunk = [&](std::size_t aChunk)
+		{
+			const std::size_t first = aChunk * PARALLEL_CHUNK_SIZE;
+			const std::size_t last	= std::min(first + PARALLEL_CHUNK_SIZE, numElements);
+
+			std::size_t offset = chunkOffsets[aChunk];
+			for (std::size_t i = first; i < last; ++i)
+				offset += SerializeImpl<T>{}.Read(aOutData[i], aInBytes, offset);
+
+			assert(offset == chunkOffsets[aChunk + 1] && "Chunk size does not match the read bytes!");
+		};
+
+		// elements may allocate through the allocator of the vector, which for e.g. a std::pmr arena is not 
+		// safe to share between threads, only allocators without state are therefore decoded in parallel
+		if constexpr (std::allocator_traits<Alloc>::is_always_equal::value)
+		{
+			ParallelFor(numChunks, ReadChunk);
+		}
+		else
+		{
+			for (std::size_t i = 0; i < numChunks; ++i)
+				ReadChunk(i);
+		}
+
+		return chunkOffsets[numChunks] - aOffset;
+	}
+
+	template<typename T> requires (std::is_trivially_copyable_v<T>)
+	inline constexpr std::size_t SerializeImpl<std::span<const T>>::Size(std::span<const T> aInData) const
+	{
+		std::size_t numBytes = LengthSize(aInData.size());
+
+		if constexpr (CompactInteger<T>)
+		{
+			for (const T& element : aInData)
+				numBytes += VarIntSize(ToVarIntValue(element));
+		}
+		else
+		{
+			numBytes += sizeof(T) * aInData.size();
+		}
+
+		return numBytes;
+	}
+
+	template<typename T> requires (std::is_trivially_copyable_v<T>)
+	template<ByteSink Sink>
+	inline std::size_t SerializeImpl<std::span<const T>>::Write(std::span<const T> aInData, Sink& aOutSink, std::size_t aOffset)
+	{
+		const std::size_t numElements = aInData.size();
+
+		std::size_t numBytes = WriteLength(numElements, aOutSink, aOffset);
+
+		// encoded elements are prepared in pieces that fit windowed sinks, which is all of them at once otherwise
+		const std::size_t maxPieceElements = std::max<std::size_t>(1, MaxPrepareSize(aOutSink) / (CompactInteger<T> ? MAX_VARINT_BYTES : sizeof(T)));
+
+		if constexpr (CompactInteger<T>)
+		{
+			for (std::size_t first = 0; first < numElements; first += maxPieceElements)
+			{
+				const std::span<const T> piece = aInData.subspan(first, std::min(maxPieceElements, numElements - first));
+
+				std::size_t numElementBytes = 0;
+				for (const T& element : piece)
+					numElementBytes += VarIntSize(ToVarIntValue(element));
+
+				std::byte* bytes = aOutSink.Prepare(aOffset + numBytes, numElementBytes); // one reservation for the whole piece
+
+				for (const T& element : piece)
+					bytes += EncodeVarInt(ToVarIntValue(element), bytes);
+
+				numBytes += numElementBytes;
+			}
+		}
+		else if constexpr (WireSwapped<T>)
+		{
+			for (std::size_t first = 0; first < numElements; first += maxPieceElements)
+			{
+				const std::size_t numPieceElements = std::min(maxPieceElements, numElements - first);
+
+				std::byte* bytes = aOutSink.Prepare(aOffset + numBytes, sizeof(T) * numPieceElements);
+				SwapBytesElements<T>(bytes, reinterpret_cast<const std::byte*>(aInData.data() + first), numPieceElements);
+
+				numBytes += sizeof(T) * numPieceElements;
+			}
+		}
+		else
+		{
+			WriteBytes(aOutSink, aOffset + numBytes, reinterpret_cast<const std::byte*>(aInData.data()), sizeof(T) * numElements);
+			numBytes += sizeof(T) * numElements;
+		}
+
+		return numBytes;
+	}
+	template<typename T> requires (std::is_trivially_copyable_v<T>)
+	inline std::size_t SerializeImpl<std::span<const T>>::Read(std::span<const T>& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset)
+		requires (RawSerializable<T>)
+	{
+		const std::size_t numBytes = ReadElements(aOutData, aInBytes, aOffset);
+
+		assert(reinterpret_cast<std::uintptr_t>(aOutData.data()) % alignof(T) == 0 && "Elements are not aligned in the buffer!");
+
+		return numBytes;
+	}
+
+	template<typename T, typename U> requires (!std::is_trivially_copyable_v<std::pair<T, U>>)
+	inline constexpr std::size_t SerializeImpl<std::pair<T, U>>::Size(const std::pair<T, U>& aInData) const
+		requires (Measurable<T> && Measurable<U>)
+	{
+		return SerializeImpl<T>{}.Size(aInData.first) + SerializeImpl<U>{}.Size(aInData.second);
+	}
+
+	template<typename T, typename U> requires (!std::is_trivially_copyable_v<std::pair<T, U>>)
+	template<ByteSink Sink>
+	inline std::size_t SerializeImpl<std::pair<T, U>>::Write(const std::pair<T, U>& aInData, Sink& aOutSink, std::size_t aOffset)
 	{
 		const std::size_t prevOffset = aOffset;
 
-		aOffset += SerializeImpl<T>{}.Write(aInData.first, aOutBytes, aOffset);
-		aOffset += SerializeImpl<U>{}.Write(aInData.second, aOutBytes, aOffset);
+		aOffset += SerializeImpl<T>{}.Write(aInData.first, aOutSink, aOffset);
+		aOffset += SerializeImpl<U>{}.Write(aInData.second, aOutSink, aOffset);
 
 		const std::size_t numBytes = aOffset - prevOffset;
 
 		return numBytes;
 	}
 
-	template<typename T, typename U> requires (!std::is_trivially_copyable_v<T> || !std::is_trivially_copyable_v<U>)
-	inline std::size_t SerializeImpl<std::pair<T, U>>::Read(std::pair<T, U>& aOutData, const std::vector<std::byte>& aInBytes, std::size_t aOffset)
+	template<typename T, typename U> requires (!std::is_trivially_copyable_v<std::pair<T, U>>)
+	inline std::size_t SerializeImpl<std::pair<T, U>>::Read(std::pair<T, U>& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset)
 	{
 		const std::size_t prevOffset = aOffset;
 
@@ -278,20 +1094,31 @@ namespace DaiSer
 		return numBytes;
 	}
 
-	template<typename... Ts> requires (!std::is_trivially_copyable_v<Ts> || ...)
-	inline std::size_t SerializeImpl<std::tuple<Ts...>>::Write(const std::tuple<Ts...>& aInData, std::vector<std::byte>& aOutBytes, std::size_t aOffset)
+	template<typename... Ts> requires (!std::is_trivially_copyable_v<std::tuple<Ts...>>)
+	inline constexpr std::size_t SerializeImpl<std::tuple<Ts...>>::Size(const std::tuple<Ts...>& aInData) const
+		requires (Measurable<Ts> && ...)
+	{
+		return std::apply([](const Ts&... aElements)
+		{
+			return (SerializeImpl<Ts>{}.Size(aElements) + ... + 0);
+		}, aInData);
+	}
+
+	template<typename... Ts> requires (!std::is_trivially_copyable_v<std::tuple<Ts...>>)
+	template<ByteSink Sink>
+	inline std::size_t SerializeImpl<std::tuple<Ts...>>::Write(const std::tuple<Ts...>& aInData, Sink& aOutSink, std::size_t aOffset)
 	{
 		const std::size_t prevOffset = aOffset;
 
-		aOffset = WriteTuple<>(aInData, aOutBytes, aOffset);
+		aOffset = WriteTuple<>(aInData, aOutSink, aOffset);
 
 		const std::size_t numBytes = aOffset - prevOffset;
 
 		return numBytes;
 	}
 
-	template<typename... Ts> requires (!std::is_trivially_copyable_v<Ts> || ...)
-	inline std::size_t SerializeImpl<std::tuple<Ts...>>::Read(std::tuple<Ts...>& aOutData, const std::vector<std::byte>& aInBytes, std::size_t aOffset)
+	template<typename... Ts> requires (!std::is_trivially_copyable_v<std::tuple<Ts...>>)
+	inline std::size_t SerializeImpl<std::tuple<Ts...>>::Read(std::tuple<Ts...>& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset)
 	{
 		const std::size_t prevOffset = aOffset;
 
@@ -302,14 +1129,14 @@ namespace DaiSer
 		return numBytes;
 	}
 
-	template<typename... Ts> requires (!std::is_trivially_copyable_v<Ts> || ...)
-	template<std::size_t I>
-	inline std::size_t SerializeImpl<std::tuple<Ts...>>::WriteTuple(const std::tuple<Ts...>& aInData, std::vector<std::byte>& aOutBytes, std::size_t aOffset)
+	template<typename... Ts> requires (!std::is_trivially_copyable_v<std::tuple<Ts...>>)
+	template<std::size_t I, ByteSink Sink>
+	inline std::size_t SerializeImpl<std::tuple<Ts...>>::WriteTuple(const std::tuple<Ts...>& aInData, Sink& aOutSink, std::size_t aOffset)
 	{
 		if constexpr (I != sizeof...(Ts))
 		{
-			aOffset += SerializeImpl<std::tuple_element_t<I, std::tuple<Ts...>>>{}.Write(std::get<I>(aInData), aOutBytes, aOffset);
-			return WriteTuple<I + 1>(aInData, aOutBytes, aOffset);
+			aOffset += SerializeImpl<std::tuple_element_t<I, std::tuple<Ts...>>>{}.Write(std::get<I>(aInData), aOutSink, aOffset);
+			return WriteTuple<I + 1>(aInData, aOutSink, aOffset);
 		}
 		else
 		{
@@ -317,19 +1144,363 @@ namespace DaiSer
 		}
 	}
 
-	template<typename... Ts> requires (!std::is_trivially_copyable_v<Ts> || ...)
+	template<typename... Ts> requires (!std::is_trivially_copyable_v<std::tuple<Ts...>>)
 	template<std::size_t I>
-	inline std::size_t SerializeImpl<std::tuple<Ts...>>::ReadTuple(std::tuple<Ts...>& aOutData, const std::vector<std::byte>& aInBytes, std::size_t aOffset)
+	inline std::size_t SerializeImpl<std::tuple<Ts...>>::ReadTuple(std::tuple<Ts...>& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset)
 	{
 		if constexpr (I != sizeof...(Ts))
 		{
 			aOffset += SerializeImpl<std::tuple_element_t<I, std::tuple<Ts...>>>{}.Read(std::get<I>(aOutData), aInBytes, aOffset);
-			return WriteTuple<I + 1>(aOutData, aInBytes, aOffset);
+			return ReadTuple<I + 1>(aOutData, aInBytes, aOffset);
+		}
+		else
+		{
+			return aOffset;
+		}
+	}
+
+	template<typename CharT>
+	inline constexpr std::size_t StringSize(std::basic_string_view<CharT> aInData)
+	{
+		if constexpr (IS_UTF8_ON_WIRE<CharT>)
+		{
+			const std::size_t numBytes = Utf8Size(aInData);
+			return StringLengthSize(numBytes) + numBytes;
+		}
+		else
+		{
+			return StringLengthSize(aInData.length()) + aInData.length() * sizeof(CharT);
+		}
+	}
+
+	template<typename CharT, ByteSink Sink>
+	inline std::size_t WriteString(std::basic_string_view<CharT> aInData, Sink& aOutSink, std::size_t aOffset)
+	{
+		if constexpr (std::is_same_v<CharT, char>)
+		{
+			if (StringTable* table = StringTable::GetActive())
+				return WriteTableString(aInData, *table, aOutSink, aOffset);
+		}
+
+		std::size_t length = aInData.length();
+
+		if constexpr (IS_UTF8_ON_WIRE<CharT>)
+			length = Utf8Size(aInData);
+
+		const std::size_t numBytes		= IS_UTF8_ON_WIRE<CharT> ? length : length * sizeof(CharT);
+		const std::size_t prefixBytes	= StringLengthSize(length);
+
+		if constexpr (WindowedSink<Sink> && !IS_UTF8_ON_WIRE<CharT> && !WireSwapped<CharT>)
+		{
+			// the characters are passed on as they are, long strings then do not have to fit the window
+			(void)EncodeVarInt(static_cast<std::uint64_t>(length), aOutSink.Prepare(aOffset, prefixBytes));
+			WriteBytes(aOutSink, aOffset + prefixBytes, reinterpret_cast<const std::byte*>(aInData.data()), numBytes);
+
+			return prefixBytes + numBytes;
+		}
+
+		std::byte* bytes = aOutSink.Prepare(aOffset, prefixBytes + numBytes); // the prefix and the characters at once
+		(void)EncodeVarInt(static_cast<std::uint64_t>(length), bytes);
+
+		if constexpr (IS_UTF8_ON_WIRE<CharT>)
+			(void)EncodeUtf8(aInData, bytes + prefixBytes);
+		else if constexpr (WireSwapped<CharT>)
+			SwapBytesElements<CharT>(bytes + prefixBytes, reinterpret_cast<const std::byte*>(aInData.data()), length);
+		else if (numBytes != 0)
+			std::memcpy(bytes + prefixBytes, aInData.data(), numBytes);
+
+		return prefixBytes + numBytes;
+	}
+
+	template<typename String>
+	inline std::size_t ReadString(String& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset)
+	{
+		using CharT = typename String::value_type;
+
+		static constexpr std::size_t WIRE_CHAR_SIZE = IS_UTF8_ON_WIRE<CharT> ? 1 : sizeof(CharT);
+
+		if constexpr (std::is_same_v<CharT, char>)
+		{
+			if (StringTable* table = StringTable::GetActive())
+			{
+				std::string_view string;
+				const std::size_t numBytes = ReadTableString(string, *table, aInBytes, aOffset);
+
+				aOutData.assign(string.data(), string.length());
+
+				return numBytes;
+			}
+		}
+
+		std::size_t length = 0;
+		const std::size_t prefixBytes = ReadStringLength(length, aInBytes, aOffset);
+
+		assert(length <= (aInBytes.size() - aOffset - prefixBytes) / WIRE_CHAR_SIZE && "Not enough memory to read from!");
+
+		const std::byte* begin = aInBytes.data() + aOffset + prefixBytes;
+		const std::size_t numBytes = length * WIRE_CHAR_SIZE;
+
+		if constexpr (IS_UTF8_ON_WIRE<CharT>)
+		{
+			aOutData.resize(length); // at most one character per byte
+			aOutData.resize(DecodeUtf8({ begin, numBytes }, aOutData.data()));
+		}
+		else if constexpr (sizeof(CharT) == 1)
+		{
+			aOutData.assign(reinterpret_cast<const CharT*>(begin), length);
 		}
 		else
 		{
+			aOutData.resize(length);
+
+			if constexpr (WireSwapped<CharT>)
+				SwapBytesElements<CharT>(reinterpret_cast<std::byte*>(aOutData.data()), begin, length);
+			else if (numBytes != 0)
+				std::memcpy(aOutData.data(), begin, numBytes);
+		}
+
+		return prefixBytes + numBytes;
+	}
+
+	template<ByteSink Sink>
+	inline std::size_t WriteTableString(std::string_view aInData, StringTable& aTable, Sink& aOutSink, std::size_t aOffset)
+	{
+		const std::size_t index = aTable.FindOrAdd(aInData); // a new string is added at the same point by the reader
+
+		if (index != StringTable::NOT_FOUND)
+		{
+			const std::uint64_t header		= (static_cast<std::uint64_t>(index) << 1) | 1;
+			const std::size_t headerBytes	= VarIntSize(header);
+
+			(void)EncodeVarInt(header, aOutSink.Prepare(aOffset, headerBytes));
+
+			return headerBytes;
+		}
+
+		const std::uint64_t header		= static_cast<std::uint64_t>(aInData.length()) << 1;
+		const std::size_t headerBytes	= VarIntSize(header);
+
+		if constexpr (WindowedSink<Sink>)
+		{
+			(void)EncodeVarInt(header, aOutSink.Prepare(aOffset, headerBytes));
+			WriteBytes(aOutSink, aOffset + headerBytes, reinterpret_cast<const std::byte*>(aInData.data()), aInData.length());
+		}
+		else
+		{
+			std::byte* bytes = aOutSink.Prepare(aOffset, headerBytes + aInData.length());
+			(void)EncodeVarInt(header, bytes);
+
+			if (!aInData.empty())
+				std::memcpy(bytes + headerBytes, aInData.data(), aInData.length());
+		}
+
+		return headerBytes + aInData.length();
+	}
+
+	inline constexpr std::size_t SerializeImpl<std::string>::Size(const std::string& aInData) const noexcept
+	{
+		return StringSize<char>(aInData);
+	}
+
+	template<ByteSink Sink>
+	inline std::size_t SerializeImpl<std::string>::Write(const std::string& aInData, Sink& aOutSink, std::size_t aOffset)
+	{
+		return WriteString<char>(aInData, aOutSink, aOffset);
+	}
+
+	inline std::size_t SerializeImpl<std::wstring>::Size(const std::wstring& aInData) const noexcept
+	{
+		return StringSize<wchar_t>(aInData);
+	}
+
+	template<ByteSink Sink>
+	inline std::size_t SerializeImpl<std::wstring>::Write(const std::wstring& aInData, Sink& aOutSink, std::size_t aOffset)
+	{
+		return WriteString<wchar_t>(aInData, aOutSink, aOffset);
+	}
+
+	inline constexpr std::size_t SerializeImpl<std::string_view>::Size(std::string_view aInData) const noexcept
+	{
+		return StringSize<char>(aInData);
+	}
+
+	template<ByteSink Sink>
+	inline std::size_t SerializeImpl<std::string_view>::Write(std::string_view aInData, Sink& aOutSink, std::size_t aOffset)
+	{
+		return WriteString<char>(aInData, aOutSink, aOffset);
+	}
+
+	template<typename CharT, typename Traits, typename Alloc>
+	inline constexpr std::size_t SerializeImpl<std::basic_string<CharT, Traits, Alloc>>::Size(const std::basic_string<CharT, Traits, Alloc>& aInData) const noexcept
+	{
+		return StringSize<CharT>({ aInData.data(), aInData.length() });
+	}
+
+	template<typename CharT, typename Traits, typename Alloc>
+	template<ByteSink Sink>
+	inline std::size_t SerializeImpl<std::basic_string<CharT, Traits, Alloc>>::Write(const std::basic_string<CharT, Traits, Alloc>& aInData, Sink& aOutSink, std::size_t aOffset)
+	{
+		return WriteString<CharT>({ aInData.data(), aInData.length() }, aOutSink, aOffset);
+	}
+
+	template<typename CharT, typename Traits, typename Alloc>
+	inline std::size_t SerializeImpl<std::basic_string<CharT, Traits, Alloc>>::Read(std::basic_string<CharT, Traits, Alloc>& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset)
+	{
+		return ReadString(aOutData, aInBytes, aOffset);
+	}
+
+	template<typename Map>
+	inline constexpr std::size_t SerializeMapImpl<Map>::Size(const Map& aInData) const
+		requires (Measurable<Key> && Measurable<Value>)
+	{
+		std::size_t numBytes = LengthSize(aInData.size());
+
+		for (const auto& [key, value] : aInData)
+			numBytes += SerializeImpl<Key>{}.Size(key) + SerializeImpl<Value>{}.Size(value);
+
+		return numBytes;
+	}
+
+	template<typename Map>
+	template<ByteSink Sink>
+	inline std::size_t SerializeMapImpl<Map>::Write(const Map& aInData, Sink& aOutSink, std::size_t aOffset)
+	{
+		std::size_t numBytes = WriteLength(aInData.size(), aOutSink, aOffset);
+
+		for (const auto& [key, value] : aInData)
+		{
+			numBytes += SerializeImpl<Key>{}.Write(key, aOutSink, aOffset + numBytes);
+			numBytes += SerializeImpl<Value>{}.Write(value, aOutSink, aOffset + numBytes);
+		}
+
+		return numBytes;
+	}
+
+	template<typename Map>
+	inline std::size_t SerializeMapImpl<Map>::Read(Map& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset)
+	{
+		std::size_t numEntries = 0;
+		std::size_t numBytes = ReadLength(numEntries, aInBytes, aOffset);
+
+		aOutData.clear();
+
+		if constexpr (requires { aOutData.reserve(numEntries); })
+			aOutData.reserve(numEntries);
+
+		for (std::size_t i = 0; i < numEntries; ++i)
+		{
+			Key key = std::make_obj_using_allocator<Key>(aOutData.get_allocator());
+			numBytes += SerializeImpl<Key>{}.Read(key, aInBytes, aOffset + numBytes);
+
+			Value value = std::make_obj_using_allocator<Value>(aOutData.get_allocator());
+			numBytes += SerializeImpl<Value>{}.Read(value, aInBytes, aOffset + numBytes);
+
+			aOutData.emplace_hint(aOutData.end(), std::move(key), std::move(value)); // ordered maps are written in order
+		}
+
+		return numBytes;
+	}
+
+	template<RawSerializable T>
+	inline std::size_t ReadElements(std::span<const T>& aOutElements, std::span<const std::byte> aInBytes, std::size_t aOffset)
+	{
+		std::size_t numElements = 0;
+		const std::size_t prefixBytes = ReadLength(numElements, aInBytes, aOffset);
+
+		const std::size_t numBytes = sizeof(T) * numElements;
+
+		assert((aOffset + prefixBytes + numBytes) <= aInBytes.size() && "Not enough memory to read from!");
+
+		aOutElements = { reinterpret_cast<const T*>(aInBytes.data() + aOffset + prefixBytes), numElements };
+
+		return prefixBytes + numBytes;
+	}
+
+	template<std::size_t I, typename Tuple, ByteSink Sink>
+	inline std::size_t WriteMembers(const Tuple& aMembers, Sink& aOutSink, std::size_t aOffset, const std::byte* aRunBegin, std::size_t aRunSize)
+	{
+		const auto FlushRun = [&]()
+		{
+			if (aRunSize != 0)
+			{
+				std::memcpy(aOutSink.Prepare(aOffset, aRunSize), aRunBegin, aRunSize);
+				aOffset += aRunSize;
+			}
+		};
+
+		if constexpr (I == std::tuple_size_v<Tuple>)
+		{
+			FlushRun();
 			return aOffset;
 		}
+		else
+		{
+			using Member = std::remove_cvref_t<std::tuple_element_t<I, Tuple>>;
+
+			const Member& member = std::get<I>(aMembers);
+
+			if constexpr (RawSerializable<Member>)
+			{
+				const std::byte* address = reinterpret_cast<const std::byte*>(std::addressof(member));
+
+				if (aRunBegin + aRunSize == address) // adjacent without padding, address comparisons are folded at compile time
+					return WriteMembers<I + 1>(aMembers, aOutSink, aOffset, aRunBegin, aRunSize + sizeof(Member));
+
+				FlushRun();
+				return WriteMembers<I + 1>(aMembers, aOutSink, aOffset, address, sizeof(Member));
+			}
+			else
+			{
+				FlushRun();
+				aOffset += SerializeImpl<Member>{}.Write(member, aOutSink, aOffset);
+
+				return WriteMembers<I + 1>(aMembers, aOutSink, aOffset);
+			}
+		}
+	}
+
+	template<std::size_t I, typename Tuple>
+	inline std::size_t ReadMembers(const Tuple& aMembers, std::span<const std::byte> aInBytes, std::size_t aOffset, std::byte* aRunBegin, std::size_t aRunSize)
+	{
+		const auto FlushRun = [&]()
+		{
+			if (aRunSize != 0)
+			{
+				assert((aOffset + aRunSize) <= aInBytes.size() && "Not enough memory to read from!");
+				std::memcpy(aRunBegin, aInBytes.data() + aOffset, aRunSize);
+				aOffset += aRunSize;
+			}
+		};
+
+		if constexpr (I == std::tuple_size_v<Tuple>)
+		{
+			FlushRun();
+			return aOffset;
+		}
+		else
+		{
+			using Member = std::remove_cvref_t<std::tuple_element_t<I, Tuple>>;
+
+			Member& member = std::get<I>(aMembers);
+
+			if constexpr (RawSerializable<Member>)
+			{
+				std::byte* address = reinterpret_cast<std::byte*>(std::addressof(member));
+
+				if (aRunBegin + aRunSize == address)
+					return ReadMembers<I + 1>(aMembers, aInBytes, aOffset, aRunBegin, aRunSize + sizeof(Member));
+
+				FlushRun();
+				return ReadMembers<I + 1>(aMembers, aInBytes, aOffset, address, sizeof(Member));
+			}
+			else
+			{
+				FlushRun();
+				aOffset += SerializeImpl<Member>{}.Read(member, aInBytes, aOffset);
+
+				return ReadMembers<I + 1>(aMembers, aInBytes, aOffset);
+			}
+		}
 	}
 
 	template<typename T>
@@ -341,7 +1512,7 @@ namespace DaiSer
 	template<typename T>
 	inline ReadSerializer& operator>>(ReadSerializer& aReadSerializer, T& aOutData)
 	{
-		aReadSerializer.Serialize(aOutData);
+		aReadSerializer.Deserialize(aOutData);
 		return aReadSerializer;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,517 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <algorithm>
+#include <filesystem>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <DaiSer/Config.h>
+#include <DaiSer/Utility/Reflection.hpp>
+
+#include "OutputSink.h"
+#include "MappedFile.h"
+
+/// Snapshots are laid out so that they are accessed where they lie in memory, without being decoded first,
+/// which makes opening a mapped file cost only the mapping itself:
+///
+///		WriteSnapshotFile(entities, "entities.snap");
+///
+///		SnapshotFile<std::vector<Entity>> file("entities.snap");
+///		for (SnapshotView<Entity> entity : file.GetRoot())
+///			std::string_view name = entity.Get<2>();
+///
+/// Every value has a slot of fixed size at its natural alignment. Trivially copyable values are stored in
+/// their slot as they are and accessed through a reference, aggregates lay out the slots of their members
+/// as the compiler would, and strings and vectors store a SnapshotRef in their slot to their contents,
+/// which are placed after the slot. Vectors of trivially copyable values are accessed as std::span.
+///
+/// Snapshots are in the byte order of the machine that wrote them, regardless of DAISER_WIRE_BIG_ENDIAN,
+/// and only the header is checked when opened, which throws std::runtime_error if it does not describe a
+/// snapshot of the root type that fits in the memory. The contents are not checked, so snapshots are
+/// meant for data that the process trusts.
+
+namespace DaiSer
+{
+	/// Alignment of the start of a snapshot, which both buffers and mapped files provide
+	/// 
+	inline constexpr std::size_t SNAPSHOT_ALIGNMENT = alignof(std::max_align_t);
+
+	inline constexpr std::uint32_t SNAPSHOT_MAGIC		= 0x4E535344; // "DSSN"
+	inline constexpr std::uint32_t SNAPSHOT_BYTE_ORDER	= 0x01020304; // reads differently on machines of another byte order
+
+	struct SnapshotHeader
+	{
+		std::uint32_t	magic		= SNAPSHOT_MAGIC;
+		std::uint32_t	byteOrder	= SNAPSHOT_BYTE_ORDER;
+		std::uint32_t	rootOffset	= 0;
+		std::uint32_t	rootSize	= 0; // size of the slot of the root, catches some mismatches of the root type
+		std::uint64_t	size		= 0;
+	};
+
+	/// Slot of strings and vectors, the contents are at an offset from the slot itself so that the
+	/// snapshot can be placed anywhere in memory
+	/// 
+	struct SnapshotRef
+	{
+		std::uint32_t	offset	= 0;
+		std::uint32_t	size	= 0; // number of characters or elements
+	};
+
+	template<typename T>
+	struct SnapshotLayout;
+
+	/// Types that can be written to snapshots
+	/// 
+	template<typename T>
+	concept SnapshotType = requires { SnapshotLayout<T>::SIZE; };
+
+	/// What a value of the type is accessed as, e.g., const T& for trivially copyable types and
+	/// std::string_view for strings
+	/// 
+	template<SnapshotType T>
+	using SnapshotAccess = decltype(SnapshotLayout<T>::Get(std::declval<const std::byte*>()));
+
+	/// Appends the contents of a snapshot while it is written, slots are addressed by offset since the
+	/// buffer may move as it grows
+	/// 
+	class SnapshotBuilder
+	{
+	public:
+		explicit SnapshotBuilder(ByteBuffer& aBuffer) noexcept : myBuffer(aBuffer) {}
+
+		/// Reserves zeroed memory after everything written so far, returns its offset
+		/// 
+		NODISC std::size_t Allocate(std::size_t aNumBytes, std::size_t aAlignment);
+
+		NODISC std::byte* GetData(std::size_t aOffset) noexcept { return myBuffer.GetData() + aOffset; }
+
+		/// Throws std::runtime_error if the distance to the contents or their size does not fit in 32 bits
+		/// 
+		void WriteRef(std::size_t aSlot, std::size_t aTarget, std::size_t aSize);
+
+	private:
+		ByteBuffer& myBuffer;
+	};
+
+	/// Accessor of an aggregate whose members are not all trivially copyable. The view points into the
+	/// snapshot, which must outlive it.
+	/// 
+	template<typename T>
+	class SnapshotView
+	{
+	public:
+		static constexpr std::size_t NUM_MEMBERS = MemberCount<T>;
+
+		template<std::size_t I>
+		using MemberType = std::remove_cvref_t<std::tuple_element_t<I, MemberTypes<T>>>;
+
+		SnapshotView() = default;
+		explicit SnapshotView(const std::byte* aData) noexcept : myData(aData) {}
+
+		/// Accesses a single member in place
+		/// 
+		template<std::size_t I>
+		NODISC SnapshotAccess<MemberType<I>> Get() const noexcept;
+
+		/// Copies the whole value out of the snapshot
+		/// 
+		NODISC T ToValue() const;
+
+		NODISC const std::byte* GetData() const noexcept { return myData; }
+
+	private:
+		const std::byte* myData = nullptr;
+	};
+
+	/// Accessor of a vector whose elements are not trivially copyable, the elements are accessed as their
+	/// SnapshotAccess. The array points into the snapshot, which must outlive it.
+	/// 
+	template<typename T>
+	class SnapshotArray
+	{
+	public:
+		class Iterator
+		{
+		public:
+			using iterator_concept	= std::forward_iterator_tag;
+			using iterator_category	= std::input_iterator_tag; // elements are accessed by value
+			using value_type		= std::remove_cvref_t<SnapshotAccess<T>>;
+			using difference_type	= std::ptrdiff_t;
+
+			Iterator() = default;
+			explicit Iterator(const std::byte* aData) noexcept : myData(aData) {}
+
+			NODISC SnapshotAccess<T> operator*() const noexcept { return SnapshotLayout<T>::Get(myData); }
+
+			Iterator& operator++() noexcept { myData += SnapshotLayout<T>::SIZE; return *this; }
+			Iterator operator++(int) noexcept { Iterator copy = *this; ++*this; return copy; }
+
+			NODISC bool operator==(const Iterator&) const noexcept = default;
+
+		private:
+			const std::byte* myData = nullptr;
+		};
+
+		SnapshotArray() = default;
+		SnapshotArray(const std::byte* aData, std::size_t aSize) noexcept : myData(aData), mySize(aSize) {}
+
+		NODISC std::size_t GetSize() const noexcept { return mySize; }
+		NODISC bool IsEmpty() const noexcept { return mySize == 0; }
+
+		NODISC SnapshotAccess<T> operator[](std::size_t aIndex) const noexcept
+		{
+			assert(aIndex < mySize && "Index is out of range!");
+			return SnapshotLayout<T>::Get(myData + aIndex * SnapshotLayout<T>::SIZE);
+		}
+
+		NODISC Iterator begin() const noexcept { return Iterator(myData); }
+		NODISC Iterator end() const noexcept { return Iterator(myData + mySize * SnapshotLayout<T>::SIZE); }
+
+	private:
+		const std::byte*	myData	= nullptr;
+		std::size_t			mySize	= 0;
+	};
+
+	/// Trivially copyable values are copied into their slot as they are, pointers are excluded since they
+	/// would not point to anything once the snapshot is loaded
+	/// 
+	template<typename T>
+		requires (std::is_trivially_copyable_v<T> && !std::is_pointer_v<T> && !std::is_member_pointer_v<T>)
+	struct SnapshotLayout<T>
+	{
+		static constexpr std::size_t SIZE	= sizeof(T);
+		static constexpr std::size_t ALIGN	= alignof(T);
+
+		static constexpr bool IS_PLAIN = true;
+
+		static void Write(const T& aInData, SnapshotBuilder& aBuilder, std::size_t aSlot)
+		{
+			std::memcpy(aBuilder.GetData(aSlot), &aInData, sizeof(T));
+		}
+
+		NODISC static const T& Get(const std::byte* aSlot) noexcept
+		{
+			return *reinterpret_cast<const T*>(aSlot);
+		}
+
+		NODISC static T Load(const std::byte* aSlot)
+		{
+			return Get(aSlot);
+		}
+	};
+
+	/// Strings are followed by a null terminator that is not part of their size
+	/// 
+	template<typename String>
+	struct SnapshotStringLayout
+	{
+		static constexpr std::size_t SIZE	= sizeof(SnapshotRef);
+		static constexpr std::size_t ALIGN	= alignof(SnapshotRef);
+
+		static constexpr bool IS_PLAIN = false;
+
+		static void Write(const String& aInData, SnapshotBuilder& aBuilder, std::size_t aSlot)
+		{
+			const std::size_t target = aBuilder.Allocate(aInData.size() + 1, 1);
+
+			std::memcpy(aBuilder.GetData(target), aInData.data(), aInData.size());
+			aBuilder.WriteRef(aSlot, target, aInData.size());
+		}
+
+		NODISC static std::string_view Get(const std::byte* aSlot) noexcept
+		{
+			const SnapshotRef& ref = *reinterpret_cast<const SnapshotRef*>(aSlot);
+			return { reinterpret_cast<const char*>(aSlot + ref.offset), ref.size };
+		}
+
+		NODISC static String Load(const std::byte* aSlot)
+		{
+			const std::string_view string = Get(aSlot);
+			return String(string.data(), string.size());
+		}
+	};
+
+	template<typename Traits, typename Alloc>
+	struct SnapshotLayout<std::basic_string<char, Traits, Alloc>> : SnapshotStringLayout<std::basic_string<char, Traits, Alloc>> {};
+
+	/// Views are written as strings, and loaded as views into the snapshot
+	/// 
+	template<typename Traits>
+	struct SnapshotLayout<std::basic_string_view<char, Traits>> : SnapshotStringLayout<std::basic_string_view<char, Traits>> {};
+
+	template<SnapshotType T, typename Alloc>
+		requires (!std::is_same_v<T, bool>)
+	struct SnapshotLayout<std::vector<T, Alloc>>
+	{
+		static constexpr std::size_t SIZE	= sizeof(SnapshotRef);
+		static constexpr std::size_t ALIGN	= alignof(SnapshotRef);
+
+		static constexpr bool IS_PLAIN = false;
+
+		static void Write(const std::vector<T, Alloc>& aInData, SnapshotBuilder& aBuilder, std::size_t aSlot)
+		{
+			using Element = SnapshotLayout<T>;
+
+			const std::size_t target = aBuilder.Allocate(aInData.size() * Element::SIZE, Element::ALIGN);
+			aBuilder.WriteRef(aSlot, target, aInData.size());
+
+			if constexpr (Element::IS_PLAIN)
+			{
+				if (!aInData.empty())
+					std::memcpy(aBuilder.GetData(target), aInData.data(), aInData.size() * sizeof(T));
+			}
+			else
+			{
+				for (std::size_t i = 0; i < aInData.size(); ++i)
+					Element::Write(aInData[i], aBuilder, target + i * Element::SIZE);
+			}
+		}
+
+		NODISC static auto Get(const std::byte* aSlot) noexcept
+		{
+			const SnapshotRef& ref = *reinterpret_cast<const SnapshotRef*>(aSlot);
+
+			if constexpr (SnapshotLayout<T>::IS_PLAIN)
+				return std::span<const T>(reinterpret_cast<const T*>(aSlot + ref.offset), ref.size);
+			else
+				return SnapshotArray<T>(aSlot + ref.offset, ref.size);
+		}
+
+		NODISC static std::vector<T, Alloc> Load(const std::byte* aSlot)
+		{
+			if constexpr (SnapshotLayout<T>::IS_PLAIN)
+			{
+				const std::span<const T> elements = Get(aSlot);
+				return std::vector<T, Alloc>(elements.begin(), elements.end());
+			}
+			else
+			{
+				const SnapshotRef& ref = *reinterpret_cast<const SnapshotRef*>(aSlot);
+
+				std::vector<T, Alloc> result;
+				result.reserve(ref.size);
+
+				for (std::size_t i = 0; i < ref.size; ++i)
+					result.emplace_back(SnapshotLayout<T>::Load(aSlot + ref.offset + i * SnapshotLayout<T>::SIZE));
+
+				return result;
+			}
+		}
+	};
+
+	template<ReflectableAggregate T>
+	inline constexpr bool SNAPSHOT_MEMBERS = []<std::size_t... Is>(std::index_sequence<Is...>)
+	{
+		return (SnapshotType<std::remove_cvref_t<std::tuple_element_t<Is, MemberTypes<T>>>> && ...);
+	}(std::make_index_sequence<MemberCount<T>>{});
+
+	/// Aggregates place the slots of their members in declaration order at their natural alignment, as the
+	/// compiler places the members themselves
+	/// 
+	template<typename T>
+		requires (!std::is_trivially_copyable_v<T> && ReflectableAggregate<T> && SNAPSHOT_MEMBERS<T>)
+	struct SnapshotLayout<T>
+	{
+	private:
+		template<std::size_t I>
+		using Member = SnapshotLayout<std::remove_cvref_t<std::tuple_element_t<I, MemberTypes<T>>>>;
+
+		static constexpr auto LAYOUT = []<std::size_t... Is>(std::index_sequence<Is...>)
+		{
+			struct Result
+			{
+				std::array<std::size_t, sizeof...(Is)>	offsets{};
+				std::size_t								size	= 0;
+				std::size_t								align	= 1;
+			} result;
+
+			std::size_t index = 0;
+
+			([&]
+			{
+				result.offsets[index++]	= (result.size + Member<Is>::ALIGN - 1) / Member<Is>::ALIGN * Member<Is>::ALIGN;
+				result.size				= result.offsets[index - 1] + Member<Is>::SIZE;
+				result.align			= std::max(result.align, Member<Is>::ALIGN);
+			}(), ...);
+
+			result.size = (result.size + result.align - 1) / result.align * result.align;
+
+			return result;
+		}(std::make_index_sequence<MemberCount<T>>{});
+
+	public:
+		static constexpr std::size_t SIZE	= LAYOUT.size;
+		static constexpr std::size_t ALIGN	= LAYOUT.align;
+
+		static constexpr bool IS_PLAIN = false;
+
+		/// Offset of the slot of the member within the slot of the aggregate
+		/// 
+		template<std::size_t I>
+		static constexpr std::size_t MEMBER_OFFSET = LAYOUT.offsets[I];
+
+		static void Write(const T& aInData, SnapshotBuilder& aBuilder, std::size_t aSlot)
+		{
+			[&]<std::size_t... Is>(std::index_sequence<Is...>)
+			{
+				const auto members = TieMembers(aInData);
+				(Member<Is>::Write(std::get<Is>(members), aBuilder, aSlot + MEMBER_OFFSET<Is>), ...);
+			}(std::make_index_sequence<MemberCount<T>>{});
+		}
+
+		NODISC static SnapshotView<T> Get(const std::byte* aSlot) noexcept
+		{
+			return SnapshotView<T>(aSlot);
+		}
+
+		NODISC static T Load(const std::byte* aSlot)
+		{
+			return SnapshotView<T>(aSlot).ToValue();
+		}
+	};
+
+	/// Writes the value as a snapshot into the buffer, replacing its contents. Throws std::runtime_error if
+	/// a string or vector has 2^32 elements or more, or its contents are placed 4 GiB or more after its slot.
+	/// 
+	template<SnapshotType T>
+	void WriteSnapshot(const T& aRoot, ByteBuffer& aOutBuffer);
+
+	template<SnapshotType T>
+	NODISC ByteBuffer WriteSnapshot(const T& aRoot);
+
+	/// Writes the value as a snapshot to the file, throws std::runtime_error if the file could not be written
+	/// 
+	template<SnapshotType T>
+	void WriteSnapshotFile(const T& aRoot, const std::filesystem::path& aPath);
+
+	DAISER_API void WriteSnapshotFile(std::span<const std::byte> aSnapshot, const std::filesystem::path& aPath);
+
+	/// Checks the header of the snapshot and returns the slot of the root, throws std::runtime_error if the
+	/// memory is misaligned, is not a snapshot of this byte order and root size, or is shorter than the header says
+	/// 
+	NODISC DAISER_API const std::byte* FindSnapshotRoot(std::span<const std::byte> aSnapshot, std::size_t aRootSize);
+
+	/// Returns the accessor of the root, nothing is decoded. The snapshot must outlive everything accessed
+	/// through it, and start at SNAPSHOT_ALIGNMENT, as buffers and mapped files do. Throws std::runtime_error
+	/// if the header does not check out.
+	/// 
+	template<SnapshotType T>
+	NODISC SnapshotAccess<T> OpenSnapshot(std::span<const std::byte> aSnapshot);
+
+	/// Snapshot that is accessed straight from a mapped file, pages are loaded by the OS as they are touched
+	/// 
+	template<SnapshotType T>
+	class SnapshotFile
+	{
+	public:
+		/// Throws std::runtime_error if the file could not be opened or mapped, or is not a snapshot of T
+		/// 
+		explicit SnapshotFile(const std::filesystem::path& aPath)
+			: myFile(aPath), myRoot(FindSnapshotRoot(myFile, SnapshotLayout<T>::SIZE)) {}
+
+		NODISC SnapshotAccess<T> GetRoot() const noexcept { return SnapshotLayout<T>::Get(myRoot); }
+
+		NODISC const MappedFile& GetFile() const noexcept { return myFile; }
+
+	private:
+		MappedFile			myFile;
+		const std::byte*	myRoot = nullptr;
+	};
+
+	inline std::size_t SnapshotBuilder::Allocate(std::size_t aNumBytes, std::size_t aAlignment)
+	{
+		const std::size_t end		= myBuffer.GetSize();
+		const std::size_t offset	= (end + aAlignment - 1) / aAlignment * aAlignment;
+
+		std::memset(myBuffer.Prepare(end, offset - end + aNumBytes), 0, offset - end + aNumBytes);
+
+		return offset;
+	}
+
+	inline void SnapshotBuilder::WriteRef(std::size_t aSlot, std::size_t aTarget, std::size_t aSize)
+	{
+		assert(aTarget >= aSlot && "Contents are placed after their slot!");
+
+		if (aTarget - aSlot > UINT32_MAX || aSize > UINT32_MAX)
+			throw std::runtime_error("Snapshot: a string or vector does not fit the 32-bit offset and size of its slot");
+
+		const SnapshotRef ref{ static_cast<std::uint32_t>(aTarget - aSlot), static_cast<std::uint32_t>(aSize) };
+		std::memcpy(myBuffer.GetData() + aSlot, &ref, sizeof(ref));
+	}
+
+	template<typename T>
+	template<std::size_t I>
+	inline SnapshotAccess<typename SnapshotView<T>::template MemberType<I>> SnapshotView<T>::Get() const noexcept
+	{
+		static_assert(I < NUM_MEMBERS, "Member index is out of range");
+		return SnapshotLayout<MemberType<I>>::Get(myData + SnapshotLayout<T>::template MEMBER_OFFSET<I>);
+	}
+
+	template<typename T>
+	inline T SnapshotView<T>::ToValue() const
+	{
+		return [this]<std::size_t... Is>(std::index_sequence<Is...>)
+		{
+			return T{ SnapshotLayout<MemberType<Is>>::Load(myData + SnapshotLayout<T>::template MEMBER_OFFSET<Is>)... };
+		}(std::make_index_sequence<NUM_MEMBERS>{});
+	}
+
+	template<SnapshotType T>
+	inline void WriteSnapshot(const T& aRoot, ByteBuffer& aOutBuffer)
+	{
+		static_assert(SnapshotLayout<T>::ALIGN <= SNAPSHOT_ALIGNMENT, "Type is aligned beyond what snapshots provide");
+		static_assert(SnapshotLayout<T>::SIZE <= UINT32_MAX, "Slot of the root is larger than the header can describe");
+
+		aOutBuffer.Clear();
+
+		SnapshotBuilder builder(aOutBuffer);
+
+		const std::size_t headerOffset	= builder.Allocate(sizeof(SnapshotHeader), alignof(SnapshotHeader));
+		const std::size_t rootOffset	= builder.Allocate(SnapshotLayout<T>::SIZE, SnapshotLayout<T>::ALIGN);
+
+		SnapshotLayout<T>::Write(aRoot, builder, rootOffset);
+
+		if (rootOffset > UINT32_MAX)
+			throw std::runtime_error("Snapshot: root lies beyond what the header can describe");
+
+		SnapshotHeader header;
+		header.rootOffset	= static_cast<std::uint32_t>(rootOffset);
+		header.rootSize		= static_cast<std::uint32_t>(SnapshotLayout<T>::SIZE);
+		header.size			= aOutBuffer.GetSize();
+
+		std::memcpy(builder.GetData(headerOffset), &header, sizeof(header));
+	}
+
+	template<SnapshotType T>
+	inline ByteBuffer WriteSnapshot(const T& aRoot)
+	{
+		ByteBuffer buffer;
+		WriteSnapshot(aRoot, buffer);
+
+		return buffer;
+	}
+
+	template<SnapshotType T>
+	inline void WriteSnapshotFile(const T& aRoot, const std::filesystem::path& aPath)
+	{
+		WriteSnapshotFile(WriteSnapshot(aRoot), aPath);
+	}
+
+	template<SnapshotType T>
+	inline SnapshotAccess<T> OpenSnapshot(std::span<const std::byte> aSnapshot)
+	{
+		return SnapshotLayout<T>::Get(FindSnapshotRoot(aSnapshot, SnapshotLayout<T>::SIZE));
+	}
+}
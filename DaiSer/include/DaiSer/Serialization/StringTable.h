@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include <DaiSer/Config.h>
+
+/// Dictionary encoding of repeated strings. While a serializer has a table set, the first occurrence of
+/// every string is written as usual and becomes an entry of the table, and later occurrences are written
+/// as the varint index of the entry. The reader rebuilds the same table as it reads, so the entries are
+/// never written separately:
+///
+///		StringTable writeTable;
+///		writer.SetStringTable(&writeTable);
+///		writer << tags;
+///
+///		StringTable readTable;
+///		reader.SetStringTable(&readTable);
+///		reader >> tags;
+///
+/// A table can be kept for a whole stream of messages, as long as the messages are read in the order
+/// they were written, or cleared for every message. Strings read as std::string_view may point into
+/// the table, which must then outlive them.
+///
+/// Large vectors are not split into chunks for parallel encoding while a table is set, see
+/// DAISER_PARALLEL_THRESHOLD, so both sides must agree on whether a table is used. IndexedVector
+/// elements are read in any order and are always written without the table.
+
+namespace DaiSer
+{
+	class StringTable
+	{
+	public:
+		static constexpr std::size_t NOT_FOUND = SIZE_MAX;
+
+		static constexpr std::size_t MIN_LENGTH		= 2;		// shorter strings are never larger than an index
+		static constexpr std::size_t MAX_LENGTH		= 1024;		// longer strings rarely repeat and are not kept
+		static constexpr std::size_t MAX_ENTRIES	= 1 << 16;	// keeps indices within three bytes
+
+		StringTable() = default;
+
+		StringTable(const StringTable&) = delete;
+		StringTable& operator=(const StringTable&) = delete;
+
+		/// Returns the index of the string, or NOT_FOUND if it is not in the table
+		/// 
+		NODISC DAISER_API std::size_t Find(std::string_view aString) const;
+
+		/// Adds the string as the next entry if it is within the length limits and the table is not full,
+		/// returns the stored copy or the string itself if it was not added
+		/// 
+		DAISER_API std::string_view Add(std::string_view aString);
+
+		/// Returns the index of the string if it is in the table, otherwise adds it like Add and returns 
+		/// NOT_FOUND, hashing the string only once
+		/// 
+		DAISER_API std::size_t FindOrAdd(std::string_view aString);
+
+		NODISC std::string_view Get(std::size_t aIndex) const noexcept { return myEntries[aIndex]; }
+		NODISC std::size_t GetSize() const noexcept { return myEntries.size(); }
+
+		/// Removes every entry, the memory of the entries is kept for the next ones
+		/// 
+		DAISER_API void Clear();
+
+		/// Returns the table of the serializer that is currently writing or reading on this thread, if any
+		/// 
+		NODISC static DAISER_API StringTable* GetActive() noexcept;
+
+	private:
+		static constexpr std::size_t BLOCK_SIZE		= 64 * 1024;
+		static constexpr std::size_t MIN_SLOTS		= 64;
+
+		NODISC static bool IsStorable(std::string_view aString) noexcept { return aString.size() >= MIN_LENGTH && aString.size() <= MAX_LENGTH; }
+
+		/// Returns the slot that holds the string, or the empty slot where it would be inserted
+		/// 
+		NODISC std::size_t FindSlot(std::string_view aString, std::size_t aHash) const noexcept;
+
+		std::string_view Insert(std::string_view aString, std::size_t aHash, std::size_t aSlot);
+
+		std::vector<std::string_view>			myEntries;
+		std::vector<std::size_t>				myHashes;	// of every entry, so that growing the slots does not hash again
+		std::vector<std::uint32_t>				mySlots;	// open addressing, entry index + 1 or 0 if empty, at most half full
+		std::vector<std::unique_ptr<char[]>>	myBlocks;	// the characters of the entries, never moved
+		std::size_t								myBlockIndex	= 0;
+		std::size_t								myBlockOffset	= 0;
+	};
+
+	/// Makes the table the active one on this thread for the lifetime of the scope, or no table at all
+	/// 
+	class StringTableScope
+	{
+	public:
+		DAISER_API explicit StringTableScope(StringTable* aTable) noexcept;
+		DAISER_API ~StringTableScope();
+
+		StringTableScope(const StringTableScope&) = delete;
+		StringTableScope& operator=(const StringTableScope&) = delete;
+
+	private:
+		StringTable* myPrevious = nullptr;
+	};
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+#include <DaiSer/Config.h>
+
+/// Transcoding between wchar_t text and UTF-8, where wchar_t is UTF-16 if it is 16 bits wide (Windows)
+/// and UTF-32 otherwise. Runs of ASCII, which make up most text, are converted 16 characters at a time.
+/// Unpaired surrogates, code points out of range and malformed UTF-8 are replaced with U+FFFD.
+
+namespace DaiSer
+{
+	/// Returns the number of bytes the text takes as UTF-8
+	/// 
+	NODISC DAISER_API std::size_t Utf8Size(std::wstring_view aText) noexcept;
+
+	/// Writes the text as UTF-8, aOutBytes must fit Utf8Size(aText) bytes, returns the number of bytes written
+	/// 
+	DAISER_API std::size_t EncodeUtf8(std::wstring_view aText, std::byte* aOutBytes) noexcept;
+
+	/// Writes the UTF-8 as wchar_t, aOutText must fit one character per byte, returns the number of characters written
+	/// 
+	DAISER_API std::size_t DecodeUtf8(std::span<const std::byte> aBytes, wchar_t* aOutText) noexcept;
+}
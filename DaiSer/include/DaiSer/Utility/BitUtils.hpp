@@ -2,8 +2,12 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <climits>
+#include <bit>
+#include <type_traits>
 #include <string>
 #include <array>
+#include <concepts>
 
 namespace DaiSer
 { 
@@ -12,12 +16,12 @@ namespace DaiSer
 	template<std::uint64_t... BitSizes> requires ((BitSizes + ...) == sizeof(std::uint64_t) * CHAR_BIT)
 	constexpr std::uint64_t PackValues64(const std::array<std::uint64_t, sizeof...(BitSizes)>& aValuesToPack)
 	{
-		constexpr auto ComputeDisplacements = []<std::uint64_t... BitSizes>() constexpr
+		constexpr auto ComputeDisplacements = []<std::uint64_t... Sizes>() constexpr
 		{
-			constexpr std::array<std::uint64_t, sizeof...(BitSizes)> bitArr{ BitSizes... };
-			std::array<std::uint64_t, sizeof...(BitSizes)> bitDisplacements{};
+			constexpr std::array<std::uint64_t, sizeof...(Sizes)> bitArr{ Sizes... };
+			std::array<std::uint64_t, sizeof...(Sizes)> bitDisplacements{};
 
-			for (std::uint64_t i = 1; i < sizeof...(BitSizes); ++i)
+			for (std::uint64_t i = 1; i < sizeof...(Sizes); ++i)
 				bitDisplacements[i] += bitDisplacements[i - 1] + bitArr[i - 1];
 
 			return bitDisplacements;
@@ -50,12 +54,12 @@ namespace DaiSer
 	template<std::uint32_t... BitSizes> requires ((BitSizes + ...) == sizeof(std::uint32_t) * CHAR_BIT)
 	constexpr std::uint32_t PackValues32(const std::array<std::uint32_t, sizeof...(BitSizes)>& aValuesToPack)
 	{
-		constexpr auto ComputeDisplacements = []<std::uint32_t... BitSizes>() constexpr
+		constexpr auto ComputeDisplacements = []<std::uint32_t... Sizes>() constexpr
 		{
-			constexpr std::array<std::uint32_t, sizeof...(BitSizes)> bitArr{ BitSizes... };
-			std::array<std::uint32_t, sizeof...(BitSizes)> bitDisplacements{};
+			constexpr std::array<std::uint32_t, sizeof...(Sizes)> bitArr{ Sizes... };
+			std::array<std::uint32_t, sizeof...(Sizes)> bitDisplacements{};
 
-			for (std::uint32_t i = 1; i < sizeof...(BitSizes); ++i)
+			for (std::uint32_t i = 1; i < sizeof...(Sizes); ++i)
 				bitDisplacements[i] += bitDisplacements[i - 1] + bitArr[i - 1];
 
 			return bitDisplacements;
@@ -82,4 +86,56 @@ namespace DaiSer
 		constexpr std::uint32_t bitPos = sizeof(std::uint32_t) * CHAR_BIT - (BitOffset + BitSize);
 		return (aPackedValues >> bitPos) & ((1ULL << BitSize) - 1);
 	}
+
+	/// Returns a mask with the lowest N bits set, N may be the full width of the word
+	/// 
+	constexpr std::uint64_t LowBitMask(std::uint32_t aNumBits) noexcept
+	{
+		return aNumBits >= 64 ? ~0ULL : (1ULL << aNumBits) - 1;
+	}
+
+	/// Unsigned integer of the same width as the integer or enum
+	/// 
+	template<typename T>
+	struct UnsignedOf
+	{
+		using type = std::make_unsigned_t<T>;
+	};
+
+	template<typename T> requires (std::is_enum_v<T>)
+	struct UnsignedOf<T>
+	{
+		using type = std::make_unsigned_t<std::underlying_type_t<T>>;
+	};
+
+	template<typename T>
+	using UnsignedOfT = typename UnsignedOf<T>::type;
+
+	template<typename T>
+	concept RangedValue = (std::is_integral_v<T> && !std::is_same_v<T, bool>) || std::is_enum_v<T>;
+
+	/// Number of bits needed to represent every value in [aMin, aMax]
+	/// 
+	template<RangedValue T>
+	constexpr std::uint32_t BitsRequired(T aMin, T aMax) noexcept
+	{
+		using Unsigned = UnsignedOfT<T>;
+		return static_cast<std::uint32_t>(std::bit_width(static_cast<std::uint64_t>(static_cast<Unsigned>(aMax) - static_cast<Unsigned>(aMin))));
+	}
+
+	/// Reverses the byte order of the value
+	/// 
+	template<std::unsigned_integral T>
+	constexpr T ByteSwap(T aValue) noexcept
+	{
+		T result{};
+
+		for (std::size_t i = 0; i < sizeof(T); ++i)
+		{
+			result = static_cast<T>((result << CHAR_BIT) | (aValue & 0xFF)); // recognized as a single bswap by compilers
+			aValue = static_cast<T>(aValue >> CHAR_BIT);
+		}
+
+		return result;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <bit>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+
+#include "BitUtils.hpp"
+#include "CpuFeatures.hpp"
+#include "Reflection.hpp"
+
+/// Byte order conversion of scalars, whole arrays of scalars, and aggregates of scalars. Arrays are
+/// swapped with AVX2 or SSSE3 byte shuffles when the processor supports them, chosen at runtime so that
+/// builds without /arch or -m flags use them too, otherwise one element at a time.
+
+namespace DaiSer
+{
+	template<typename T>
+	concept ByteSwappableScalar = (std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>) &&
+		(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+	template<typename T>
+	concept TupleLike = requires { std::tuple_size<T>::value; };
+
+	/// Reverses the byte order of an arithmetic, enum or pointer value
+	/// 
+	template<ByteSwappableScalar T>
+	inline T SwapBytes(T aValue) noexcept
+	{
+		if constexpr (sizeof(T) == 1)
+		{
+			return aValue;
+		}
+		else
+		{
+			using Unsigned = std::conditional_t<sizeof(T) == 2, std::uint16_t,
+							 std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>;
+
+			static_assert(sizeof(T) == sizeof(Unsigned), "Unsupported scalar size");
+
+			Unsigned bits;
+			std::memcpy(&bits, &aValue, sizeof(T));
+
+			bits = ByteSwap(bits);
+			std::memcpy(&aValue, &bits, sizeof(T));
+
+			return aValue;
+		}
+	}
+
+	/// Whether any part of the type is affected by byte order, i.e., contains scalars larger than a byte
+	/// 
+	template<typename T>
+	constexpr bool HasByteOrder()
+	{
+		if constexpr (ByteSwappableScalar<T>)
+		{
+			return sizeof(T) > 1;
+		}
+		else if constexpr (std::is_array_v<T>)
+		{
+			return HasByteOrder<std::remove_all_extents_t<T>>();
+		}
+		else if constexpr (TupleLike<T>)
+		{
+			return []<std::size_t... Is>(std::index_sequence<Is...>)
+			{
+				return (HasByteOrder<std::remove_cvref_t<std::tuple_element_t<Is, T>>>() || ...);
+			}(std::make_index_sequence<std::tuple_size_v<T>>{});
+		}
+		else if constexpr (ReflectableAggregate<T>)
+		{
+			return HasByteOrder<MemberTypes<T>>();
+		}
+		else
+		{
+			return true; // unknown layout, assume the worst
+		}
+	}
+
+#if DAISER_CPU_X64
+
+	/// Reverses each ElementSize group of bytes within a 16-byte lane
+	/// 
+	template<std::size_t ElementSize>
+	inline constexpr std::array<char, 16> BYTE_SWAP_SHUFFLE = []
+	{
+		std::array<char, 16> shuffle{};
+		for (std::size_t j = 0; j < 16; ++j)
+			shuffle[j] = static_cast<char>((j / ElementSize) * ElementSize + (ElementSize - 1 - j % ElementSize));
+
+		return shuffle;
+	}();
+
+	/// Swaps whole 16-byte blocks of the array, returns the number of bytes swapped
+	/// 
+	template<std::size_t ElementSize>
+	DAISER_TARGET("ssse3") inline std::size_t SwapBytesSSSE3(std::byte* aOut, const std::byte* aIn, std::size_t aNumBytes) noexcept
+	{
+		const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(BYTE_SWAP_SHUFFLE<ElementSize>.data()));
+
+		std::size_t i = 0;
+		for (; i + 16 <= aNumBytes; i += 16)
+		{
+			const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(aIn + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(aOut + i), _mm_shuffle_epi8(bytes, shuffle));
+		}
+
+		return i;
+	}
+
+	/// Swaps whole 32-byte blocks of the array, returns the number of bytes swapped
+	/// 
+	template<std::size_t ElementSize>
+	DAISER_TARGET("avx2") inline std::size_t SwapBytesAVX2(std::byte* aOut, const std::byte* aIn, std::size_t aNumBytes) noexcept
+	{
+		const __m256i shuffle = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(BYTE_SWAP_SHUFFLE<ElementSize>.data())));
+
+		std::size_t i = 0;
+		for (; i + 32 <= aNumBytes; i += 32)
+		{
+			const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(aIn + i));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(aOut + i), _mm256_shuffle_epi8(bytes, shuffle));
+		}
+
+		return i;
+	}
+
+#endif
+
+	/// Swaps the bytes of aNumElements scalars of ElementSize bytes each, aOut and aIn may be the same memory
+	/// 
+	template<std::size_t ElementSize>
+	inline void SwapBytesArray(std::byte* aOut, const std::byte* aIn, std::size_t aNumElements) noexcept
+	{
+		static_assert(ElementSize == 2 || ElementSize == 4 || ElementSize == 8, "Unsupported element size");
+
+		std::size_t i = 0;
+		const std::size_t numBytes = aNumElements * ElementSize;
+
+#if DAISER_CPU_X64
+		if (numBytes >= 16)
+		{
+			const CpuFeatures& features = GetCpuFeatures();
+
+			if (features.avx2)
+				i = SwapBytesAVX2<ElementSize>(aOut, aIn, numBytes);
+
+			if (features.ssse3)
+				i += SwapBytesSSSE3<ElementSize>(aOut + i, aIn + i, numBytes - i);
+		}
+#endif
+
+		using Unsigned = std::conditional_t<ElementSize == 2, std::uint16_t,
+						 std::conditional_t<ElementSize == 4, std::uint32_t, std::uint64_t>>;
+
+		for (; i < numBytes; i += ElementSize)
+		{
+			Unsigned value;
+			std::memcpy(&value, aIn + i, ElementSize);
+
+			value = ByteSwap(value);
+			std::memcpy(aOut + i, &value, ElementSize);
+		}
+	}
+
+	/// Reverses the byte order of every scalar within the value
+	/// 
+	template<typename T>
+	inline void SwapBytesInPlace(T& aValue) noexcept
+	{
+		if constexpr (!HasByteOrder<T>())
+		{
+			return;
+		}
+		else if constexpr (ByteSwappableScalar<T>)
+		{
+			aValue = SwapBytes(aValue);
+		}
+		else if constexpr (std::is_array_v<T>)
+		{
+			for (auto& element : aValue)
+				SwapBytesInPlace(element);
+		}
+		else if constexpr (TupleLike<T>)
+		{
+			[&]<std::size_t... Is>(std::index_sequence<Is...>)
+			{
+				(SwapBytesInPlace(std::get<Is>(aValue)), ...);
+			}(std::make_index_sequence<std::tuple_size_v<T>>{});
+		}
+		else if constexpr (ReflectableAggregate<T>)
+		{
+			std::apply([](auto&... aMembers) { (SwapBytesInPlace(aMembers), ...); }, TieMembers(aValue));
+		}
+		else
+		{
+			static_assert(!sizeof(T), "The byte order of the type is unknown, provide a SerializeImpl for it");
+		}
+	}
+
+	/// Swaps the bytes of every element, using the array kernels for scalars, aOut and aIn may be the same memory
+	/// 
+	template<typename T> requires (std::is_trivially_copyable_v<T>)
+	inline void SwapBytesElements(std::byte* aOut, const std::byte* aIn, std::size_t aNumElements) noexcept
+	{
+		if constexpr (!HasByteOrder<T>())
+		{
+			if (aOut != aIn && aNumElements != 0)
+				std::memcpy(aOut, aIn, aNumElements * sizeof(T));
+		}
+		else if constexpr (ByteSwappableScalar<T>)
+		{
+			SwapBytesArray<sizeof(T)>(aOut, aIn, aNumElements);
+		}
+		else
+		{
+			for (std::size_t i = 0; i < aNumElements; ++i)
+			{
+				T element;
+				std::memcpy(&element, aIn + i * sizeof(T), sizeof(T));
+
+				SwapBytesInPlace(element);
+				std::memcpy(aOut + i * sizeof(T), &element, sizeof(T));
+			}
+		}
+	}
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <DaiSer/Config.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#	define DAISER_CPU_X64 1
+#	include <immintrin.h>
+#	ifdef _MSC_VER
+#		include <intrin.h>
+#	endif
+#else
+#	define DAISER_CPU_X64 0
+#endif
+
+// enables instructions for a single function on GCC and Clang, MSVC allows every intrinsic anywhere
+#if DAISER_CPU_X64 && (defined(__GNUC__) || defined(__clang__))
+#	define DAISER_TARGET(aFeatures) __attribute__((target(aFeatures)))
+#else
+#	define DAISER_TARGET(aFeatures)
+#endif
+
+/// Instruction set extensions that are used where available without requiring the build to enable them.
+/// Kernels are compiled with DAISER_TARGET and chosen at runtime from GetCpuFeatures, which asks the
+/// processor once. Extensions that the build already enables are reported without asking.
+
+namespace DaiSer
+{
+	struct CpuFeatures
+	{
+		bool ssse3	= false;
+		bool sse42	= false;
+		bool avx2	= false;
+	};
+
+#if DAISER_CPU_X64
+
+	NODISC inline CpuFeatures DetectCpuFeatures() noexcept
+	{
+		CpuFeatures features;
+
+#if defined(_MSC_VER) && !defined(__clang__)
+		int info[4];
+
+		__cpuid(info, 0);
+		const int maxLeaf = info[0];
+
+		__cpuid(info, 1);
+		features.ssse3	= (info[2] & (1 << 9)) != 0;
+		features.sse42	= (info[2] & (1 << 20)) != 0;
+
+		const bool isAvxSaved = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6; // the OS saves the ymm registers
+
+		if (maxLeaf >= 7 && isAvxSaved)
+		{
+			__cpuidex(info, 7, 0);
+			features.avx2 = (info[1] & (1 << 5)) != 0;
+		}
+#else
+		__builtin_cpu_init();
+
+		features.ssse3	= __builtin_cpu_supports("ssse3");
+		features.sse42	= __builtin_cpu_supports("sse4.2");
+		features.avx2	= __builtin_cpu_supports("avx2");
+#endif
+
+#if defined(__SSSE3__) || defined(__AVX__)
+		features.ssse3	= true;
+#endif
+#if defined(__SSE4_2__) || defined(__AVX__)
+		features.sse42	= true;
+#endif
+#if defined(__AVX2__)
+		features.avx2	= true;
+#endif
+
+		return features;
+	}
+
+#else
+
+	NODISC inline CpuFeatures DetectCpuFeatures() noexcept
+	{
+		return {};
+	}
+
+#endif
+
+	/// Features of the processor that the program runs on, detected on the first call
+	/// 
+	NODISC inline const CpuFeatures& GetCpuFeatures() noexcept
+	{
+		static const CpuFeatures features = DetectCpuFeatures();
+		return features;
+	}
+}
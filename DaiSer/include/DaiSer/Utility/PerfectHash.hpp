@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace DaiSer
+{
+	/// Finalizer of splitmix64, every bit of the input affects every bit of the output and no two inputs share an output
+	/// 
+	constexpr std::uint64_t MixBits(std::uint64_t aValue) noexcept
+	{
+		aValue = (aValue ^ (aValue >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		aValue = (aValue ^ (aValue >> 27)) * 0x94D049BB133111EBULL;
+		return aValue ^ (aValue >> 31);
+	}
+
+	/// Maps a set of keys known at compile time to their index in the set without any collisions. Built with
+	/// hash and displace: the keys are hashed into buckets of a couple of keys each, then, largest bucket first,
+	/// every bucket searches for a displacement that moves all of its keys into free slots. A lookup is thereby
+	/// two hashes and a single comparison, regardless of the number of keys.
+	/// 
+	template<std::size_t N>
+	class PerfectHashTable
+	{
+	public:
+		static constexpr std::size_t NOT_FOUND = SIZE_MAX;
+
+		static constexpr std::size_t NUM_SLOTS		= std::bit_ceil(N + N / 2 + 1);	// at most two thirds full
+		static constexpr std::size_t NUM_BUCKETS	= N / 2 + 1;
+
+		/// Fails to compile if the keys contain duplicates
+		/// 
+		consteval explicit PerfectHashTable(const std::array<std::uint64_t, N>& aKeys);
+
+		/// Returns the index of the key in the set, or NOT_FOUND if it is not part of it
+		/// 
+		constexpr std::size_t Find(std::uint64_t aKey) const noexcept;
+
+	private:
+		static constexpr std::uint32_t EMPTY_SLOT			= UINT32_MAX;
+		static constexpr std::uint32_t MAX_DISPLACEMENT	= 1u << 24;
+
+		static constexpr std::size_t GetBucket(std::uint64_t aHash) noexcept
+		{
+			return static_cast<std::size_t>(((aHash >> 32) * NUM_BUCKETS) >> 32);
+		}
+
+		static constexpr std::size_t GetSlot(std::uint64_t aHash, std::uint32_t aDisplacement) noexcept
+		{
+			return static_cast<std::size_t>(MixBits(aHash + aDisplacement) & (NUM_SLOTS - 1));
+		}
+
+		std::array<std::uint64_t, NUM_SLOTS>		myKeys			{};
+		std::array<std::uint32_t, NUM_SLOTS>		myIndices		{};
+		std::array<std::uint32_t, NUM_BUCKETS>		myDisplacements	{};
+	};
+
+	template<std::size_t N>
+	consteval PerfectHashTable<N>::PerfectHashTable(const std::array<std::uint64_t, N>& aKeys)
+	{
+		myIndices.fill(EMPTY_SLOT);
+
+		std::array<std::size_t, NUM_BUCKETS + 1> bucketBegins{};	// keys sorted by bucket, counting sort
+		std::array<std::uint32_t, N> bucketKeys{};
+
+		for (std::size_t i = 0; i < N; ++i)
+			++bucketBegins[GetBucket(MixBits(aKeys[i])) + 1];
+
+		for (std::size_t i = 0; i < NUM_BUCKETS; ++i)
+			bucketBegins[i + 1] += bucketBegins[i];
+
+		std::array<std::size_t, NUM_BUCKETS> bucketEnds{};
+		std::copy(bucketBegins.begin(), bucketBegins.end() - 1, bucketEnds.begin());
+
+		for (std::size_t i = 0; i < N; ++i)
+			bucketKeys[bucketEnds[GetBucket(MixBits(aKeys[i]))]++] = static_cast<std::uint32_t>(i);
+
+		std::array<std::size_t, NUM_BUCKETS> order{};
+		for (std::size_t i = 0; i < NUM_BUCKETS; ++i)
+			order[i] = i;
+
+		std::sort(order.begin(), order.end(), [&bucketBegins, &bucketEnds](std::size_t aLeft, std::size_t aRight)
+		{
+			return bucketEnds[aLeft] - bucketBegins[aLeft] > bucketEnds[aRight] - bucketBegins[aRight];
+		});
+
+		for (const std::size_t bucket : order)
+		{
+			const std::size_t begin	= bucketBegins[bucket];
+			const std::size_t end	= bucketEnds[bucket];
+
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				for (std::size_t j = begin; j < i; ++j)
+				{
+					if (aKeys[bucketKeys[i]] == aKeys[bucketKeys[j]]) // equal keys always share a bucket
+						throw std::logic_error("PerfectHashTable: duplicate key");
+				}
+			}
+
+			std::uint32_t displacement = 0;
+
+			for (;; ++displacement)
+			{
+				if (displacement == MAX_DISPLACEMENT)
+					throw std::logic_error("PerfectHashTable: no displacement found");
+
+				bool isFree = true;
+
+				for (std::size_t i = begin; i < end && isFree; ++i)
+				{
+					const std::size_t slot = GetSlot(MixBits(aKeys[bucketKeys[i]]), displacement);
+
+					isFree = (myIndices[slot] == EMPTY_SLOT);
+
+					for (std::size_t j = begin; j < i && isFree; ++j) // keys of the same bucket must not collide either
+						isFree = (GetSlot(MixBits(aKeys[bucketKeys[j]]), displacement) != slot);
+				}
+
+				if (isFree)
+					break;
+			}
+
+			myDisplacements[bucket] = displacement;
+
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				const std::size_t slot = GetSlot(MixBits(aKeys[bucketKeys[i]]), displacement);
+
+				myKeys[slot]	= aKeys[bucketKeys[i]];
+				myIndices[slot]	= bucketKeys[i];
+			}
+		}
+	}
+
+	template<std::size_t N>
+	constexpr std::size_t PerfectHashTable<N>::Find(std::uint64_t aKey) const noexcept
+	{
+		const std::uint64_t hash = MixBits(aKey);
+		const std::size_t slot = GetSlot(hash, myDisplacements[GetBucket(hash)]);
+
+		if (myIndices[slot] == EMPTY_SLOT || myKeys[slot] != aKey)
+			return NOT_FOUND;
+
+		return myIndices[slot];
+	}
+}
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+
+/// Compile-time reflection of aggregates, the number of members is found by testing how many
+/// initializers the aggregate accepts, and the members are accessed through structured bindings.
+
+namespace DaiSer
+{
+	inline constexpr std::size_t MAX_AGGREGATE_MEMBERS = 32;
+
+	/// Converts to anything, used to probe how many initializers an aggregate accepts
+	/// 
+	struct AnyType
+	{
+		template<typename T>
+		operator T() const;
+	};
+
+	template<typename T, std::size_t... Is>
+	constexpr bool IsConstructibleWith(std::index_sequence<Is...>)
+	{
+		return requires { T{ (static_cast<void>(Is), AnyType{})... }; };
+	}
+
+	template<typename T, std::size_t N = MAX_AGGREGATE_MEMBERS>
+	constexpr std::size_t CountMembers()
+	{
+		if constexpr (N == 0)
+			return 0;
+		else if constexpr (IsConstructibleWith<T>(std::make_index_sequence<N>{}))
+			return N;
+		else
+			return CountMembers<T, N - 1>();
+	}
+
+	/// Number of members in the aggregate, C-array members and base classes are not supported
+	/// 
+	template<typename T>
+	inline constexpr std::size_t MemberCount = CountMembers<std::remove_cv_t<T>>();
+
+	template<typename T>
+	concept ReflectableAggregate = std::is_aggregate_v<std::remove_cv_t<T>> && !std::is_array_v<T> && 
+		(MemberCount<T> > 0) && (MemberCount<T> <= MAX_AGGREGATE_MEMBERS);
+
+	/// Returns a tuple of references to the members of the aggregate in declaration order
+	/// 
+	template<ReflectableAggregate T>
+	constexpr auto TieMembers(T& aObject) noexcept
+	{
+		constexpr std::size_t count = MemberCount<T>;
+
+		if constexpr (count == 1)
+		{
+			auto& [m0] = aObject;
+			return std::tie(m0);
+		}
+		else if constexpr (count == 2)
+		{
+			auto& [m0, m1] = aObject;
+			return std::tie(m0, m1);
+		}
+		else if constexpr (count == 3)
+		{
+			auto& [m0, m1, m2] = aObject;
+			return std::tie(m0, m1, m2);
+		}
+		else if constexpr (count == 4)
+		{
+			auto& [m0, m1, m2, m3] = aObject;
+			return std::tie(m0, m1, m2, m3);
+		}
+		else if constexpr (count == 5)
+		{
+			auto& [m0, m1, m2, m3, m4] = aObject;
+			return std::tie(m0, m1, m2, m3, m4);
+		}
+		else if constexpr (count == 6)
+		{
+			auto& [m0, m1, m2, m3, m4, m5] = aObject;
+			return std::tie(m0, m1, m2, m3, m4, m5);
+		}
+		else if constexpr (count == 7)
+		{
+			auto& [m0, m1, m2, m3, m4, m5, m6] = aObject;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6);
+		}
+		else if constexpr (count == 8)
+		{
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7] = aObject;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7);
+		}
+		else if constexpr (count == 9)
+		{
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8] = aObject;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8);
+		}
+		else if constexpr (count == 10)
+		{
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9] = aObject;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9);
+		}
+		else if constexpr (count == 11)
+		{
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10] = aObject;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10);
+		}
+		else if constexpr (count == 12)
+		{
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11] = aObject;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11);
+		}
+		else if constexpr (count == 13)
+		{
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12] = aObject;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12);
+		}
+		else if constexpr (count == 14)
+		{
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13] = aObject;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13);
+		}
+		else if constexpr (count == 15)
+		{
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14] = aObject;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14);
+		}
+		else if constexpr (count == 16)
+		{
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15] = aObject;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15);
+		}
+		else if constexpr (count == 17)
+		{
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16] = aObject;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16);
+		}
+		else if constexpr (count == 18)
+		{
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17] = aObject;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17);
+		}
+		else if constexpr (count == 19)
+		{
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18] = aObject;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18);
+		}
+		else if constexpr (count == 20)
+		{
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19] = aObject;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19);
+		}
+		else if constexpr (count == 21)
+		{
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20] = aObject;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20);
+		}
+		else if constexpr (count == 22)
+		{
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21] = aObject;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21);
+		}
+		else if constexpr (count == 23)
+		{
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22] = aObject;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22);
+		}
+		else if constexpr (count == 24)
+		{
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23] = aObject;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23);
+		}
+		else if constexpr (count == 25)
+		{
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24] = aObject;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24);
+		}
+		else if constexpr (count == 26)
+		{
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25] = aObject;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25);
+		}
+		else if constexpr (count == 27)
+		{
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26] = aObject;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26);
+		}
+		else if constexpr (count == 28)
+		{
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27] = aObject;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27);
+		}
+		else if constexpr (count == 29)
+		{
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28] = aObject;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28);
+		}
+		else if constexpr (count == 30)
+		{
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29] = aObject;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29);
+		}
+		else if constexpr (count == 31)
+		{
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30] = aObject;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30);
+		}
+		else if constexpr (count == 32)
+		{
+			auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31] = aObject;
+			return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15, m16, m17, m18, m19, m20, m21, m22, m23, m24, m25, m26, m27, m28, m29, m30, m31);
+		}
+	}
+
+	template<ReflectableAggregate T>
+	using MemberTypes = decltype(TieMembers(std::declval<T&>()));
+}
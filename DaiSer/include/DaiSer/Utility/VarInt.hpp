@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <bit>
+#include <type_traits>
+
+#include "BitUtils.hpp"
+
+namespace DaiSer
+{
+	/// Maximum number of bytes a 64-bit LEB128 value can occupy
+	/// 
+	inline constexpr std::size_t MAX_VARINT_BYTES = 10;
+
+	/// Maps signed integers to unsigned so that values close to zero stay small, e.g. 0, -1, 1, -2 -> 0, 1, 2, 3
+	/// 
+	constexpr std::uint64_t ZigZagEncode(std::int64_t aValue) noexcept
+	{
+		return (static_cast<std::uint64_t>(aValue) << 1) ^ static_cast<std::uint64_t>(aValue >> 63);
+	}
+
+	constexpr std::int64_t ZigZagDecode(std::uint64_t aValue) noexcept
+	{
+		return static_cast<std::int64_t>(aValue >> 1) ^ -static_cast<std::int64_t>(aValue & 1);
+	}
+
+	/// Converts an integer to the unsigned value that is written as a varint, signed integers are zigzagged
+	/// 
+	template<typename T> requires (std::is_integral_v<T>)
+	constexpr std::uint64_t ToVarIntValue(T aValue) noexcept
+	{
+		if constexpr (std::is_signed_v<T>)
+			return ZigZagEncode(static_cast<std::int64_t>(aValue));
+		else
+			return static_cast<std::uint64_t>(aValue);
+	}
+
+	template<typename T> requires (std::is_integral_v<T>)
+	constexpr T FromVarIntValue(std::uint64_t aValue) noexcept
+	{
+		if constexpr (std::is_signed_v<T>)
+			return static_cast<T>(ZigZagDecode(aValue));
+		else
+			return static_cast<T>(aValue);
+	}
+
+	/// Returns the number of bytes needed to encode the value as LEB128
+	/// 
+	constexpr std::size_t VarIntSize(std::uint64_t aValue) noexcept
+	{
+		// (bits * 9 + 64) / 64 is equal to max(1, ceil(bits / 7)) for bits in [0, 64]
+		return static_cast<std::size_t>((std::bit_width(aValue) * 9 + 64) / 64);
+	}
+
+	/// Encodes the value as LEB128, aOutBytes must fit at least VarIntSize(aValue) bytes
+	/// 
+	inline std::size_t EncodeVarInt(std::uint64_t aValue, std::byte* aOutBytes) noexcept
+	{
+		std::size_t numBytes = 0;
+
+		while (aValue >= 0x80)
+		{
+			aOutBytes[numBytes++] = static_cast<std::byte>(aValue | 0x80);
+			aValue >>= 7;
+		}
+
+		aOutBytes[numBytes++] = static_cast<std::byte>(aValue);
+
+		return numBytes;
+	}
+
+	/// Decodes a LEB128 value, returns the number of bytes read or 0 if the value is truncated or malformed.
+	/// 
+	/// When at least 8 bytes are available, the terminating byte is located with a single 64-bit load
+	/// and the 7-bit groups are compacted in parallel rather than one byte at a time.
+	/// 
+	inline std::size_t DecodeVarInt(const std::byte* aBytes, std::size_t aAvailable, std::uint64_t& aOutValue) noexcept
+	{
+		if (aAvailable >= sizeof(std::uint64_t)) [[likely]]
+		{
+			std::uint64_t word;
+			std::memcpy(&word, aBytes, sizeof(std::uint64_t));
+
+			if constexpr (std::endian::native == std::endian::big)
+				word = ByteSwap(word);
+
+			const std::uint64_t stopBits = ~word & 0x8080808080808080ULL;
+
+			if (stopBits != 0) [[likely]]
+			{
+				const std::size_t numBytes = (static_cast<std::size_t>(std::countr_zero(stopBits)) >> 3) + 1;
+
+				std::uint64_t value = word & (~0ULL >> (64 - numBytes * 8)) & 0x7f7f7f7f7f7f7f7fULL;
+
+				value = (value & 0x007f007f007f007fULL) | ((value & 0x7f007f007f007f00ULL) >> 1);
+				value = (value & 0x00003fff00003fffULL) | ((value & 0x3fff00003fff0000ULL) >> 2);
+				value = (value & 0x000000000fffffffULL) | ((value & 0x0fffffff00000000ULL) >> 4);
+
+				aOutValue = value;
+
+				return numBytes;
+			}
+		}
+
+		std::uint64_t value = 0;
+
+		for (std::size_t i = 0; i < aAvailable && i < MAX_VARINT_BYTES; ++i)
+		{
+			const std::uint64_t byte = static_cast<std::uint64_t>(aBytes[i]);
+			value |= (byte & 0x7f) << (7 * i);
+
+			if ((byte & 0x80) == 0)
+			{
+				aOutValue = value;
+				return i + 1;
+			}
+		}
+
+		return 0;
+	}
+}
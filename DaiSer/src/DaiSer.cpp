@@ -15,16 +15,28 @@ DSStream::operator DSScope()
 DSScope::DSScope(DSStream& aSerializer)
 	: mySerializer(&aSerializer)
 {
-
+	if (aSerializer.GetState() == DSState::In)
+		LoadNextID();
 }
 
 void DSScope::LoadNextID()
 {
+	IDSStream& in = static_cast<IDSStream&>(*mySerializer);
+
+	std::uint64_t deltaID = 0;
+	if (!in.ReadHeader(deltaID, myNextWireType))
+	{
+		myNextID = NULL_ID;
+		return;
+	}
 
+	myNextID = myPrevID + 1 + static_cast<FieldIDType>(ZigZagDecode(deltaID));
+	myPrevID = myNextID;
 }
 void DSScope::SkipField()
 {
-
+	IDSStream& in = static_cast<IDSStream&>(*mySerializer);
+	in.SkipPayload(myNextWireType);
 }
 
 DSStream::DSStream(DSState aState)
@@ -39,6 +51,13 @@ ODSStream::ODSStream()
 
 }
 
+IDSStream::IDSStream(ByteBuffer&& aBuffer)
+	: DSStream(DSState::In)
+	, myReadSerializer(std::move(aBuffer))
+{
+
+}
+
 IDSStream::IDSStream(std::vector<std::byte>&& aBuffer)
 	: DSStream(DSState::In)
 	, myReadSerializer(std::move(aBuffer))
@@ -46,9 +65,70 @@ IDSStream::IDSStream(std::vector<std::byte>&& aBuffer)
 
 }
 
+IDSStream::IDSStream(MappedFile&& aFile)
+	: DSStream(DSState::In)
+	, myReadSerializer(std::move(aFile))
+{
+
+}
+
 IDSStream::IDSStream(std::span<const std::byte> aBuffer)
 	: DSStream(DSState::In)
 	, myReadSerializer(aBuffer)
 {
 
 }
+
+void ODSStream::WriteVarInt(std::uint64_t aValue)
+{
+	const std::size_t numBytes = VarIntSize(aValue);
+	EncodeVarInt(aValue, myWriteSerializer.myBuffer.Prepare(myWriteSerializer.myOffset, numBytes));
+
+	myWriteSerializer.myOffset += numBytes;
+}
+
+bool IDSStream::ReadHeader(std::uint64_t& aOutDeltaID, WireType& aOutWireType)
+{
+	if (myReadSerializer.IsDone())
+		return false;
+
+	const std::uint64_t header = ReadVarInt();
+
+	aOutDeltaID		= GetHeaderDeltaID(header);
+	aOutWireType	= GetHeaderWireType(header);
+
+	return true;
+}
+
+void IDSStream::SkipPayload(WireType aWireType)
+{
+	std::size_t& offset = myReadSerializer.myOffset;
+
+	switch (aWireType)
+	{
+		case WireType::VarInt:			(void)ReadVarInt(); break;
+		case WireType::Fixed8:			offset += 1; break;
+		case WireType::Fixed16:			offset += 2; break;
+		case WireType::Fixed32:			offset += 4; break;
+		case WireType::Fixed64:			offset += 8; break;
+		case WireType::LengthDelimited: offset += ReadVarInt(); break; // one jump, regardless of the payload
+	}
+
+	assert(offset <= myReadSerializer.myBuffer.size() && "Skipped past the end of the buffer!");
+}
+
+std::uint64_t IDSStream::ReadVarInt()
+{
+	std::span<const std::byte> buffer	= myReadSerializer.myBuffer;
+	std::size_t& offset					= myReadSerializer.myOffset;
+
+	assert(offset <= buffer.size() && "Not enough memory to read from!");
+
+	std::uint64_t value = 0;
+	const std::size_t numBytes = DecodeVarInt(buffer.data() + offset, buffer.size() - offset, value);
+
+	assert(numBytes != 0 && "Malformed or truncated varint!");
+	offset += numBytes;
+
+	return value;
+}
@@ -0,0 +1,96 @@
+#include <DaiSer/Serialization/BitSerializer.h>
+
+using namespace DaiSer;
+
+BitWriteSerializer::BitWriteSerializer()
+	: Serializer(SerializerState::Write)
+{
+
+}
+
+void BitWriteSerializer::AlignToByte()
+{
+	WriteScratch(0, (8 - myScratchBits % 8) % 8);
+}
+
+std::span<const std::byte> BitWriteSerializer::GetBuffer()
+{
+	const std::uint32_t numPending = (myScratchBits + 7) / 8;
+
+	if (numPending != 0) // written past the offset so that later bits simply overwrite them
+	{
+		std::byte* bytes = myBuffer.Prepare(myOffset, numPending);
+
+		for (std::uint32_t i = 0; i < numPending; ++i)
+			bytes[i] = static_cast<std::byte>(myScratch >> (i * 8));
+	}
+
+	return { myBuffer.GetData(), myOffset + numPending };
+}
+
+ByteBuffer BitWriteSerializer::MoveBuffer()
+{
+	const std::size_t numBytes = GetBuffer().size();
+
+	myBuffer.Resize(numBytes);
+
+	myOffset		= 0;
+	myScratch		= 0;
+	myScratchBits	= 0;
+
+	return std::move(myBuffer);
+}
+
+void BitWriteSerializer::Clear()
+{
+	myBuffer.Clear();
+
+	myOffset		= 0;
+	myScratch		= 0;
+	myScratchBits	= 0;
+}
+
+BitReadSerializer::BitReadSerializer(std::span<const std::byte> aBuffer)
+	: Serializer(SerializerState::Read)
+	, myBuffer(aBuffer)
+{
+
+}
+
+void BitReadSerializer::AlignToByte()
+{
+	const std::uint32_t numPadding = myScratchBits % 8;
+
+	myScratch		>>= numPadding;
+	myScratchBits	-= numPadding;
+}
+
+void BitReadSerializer::Refill()
+{
+	const std::size_t remaining = myBuffer.size() - myOffset;
+	const std::uint32_t numBytes = static_cast<std::uint32_t>(std::min<std::size_t>((64 - myScratchBits) / 8, remaining));
+
+	if (numBytes == 0)
+		return;
+
+	const std::byte* bytes = myBuffer.data() + myOffset;
+
+	std::uint64_t word = 0;
+
+	if (remaining >= sizeof(word)) // single load, the bytes that do not fit are masked away below
+	{
+		std::memcpy(&word, bytes, sizeof(word));
+
+		if constexpr (std::endian::native == std::endian::big)
+			word = ByteSwap(word);
+	}
+	else
+	{
+		for (std::uint32_t i = 0; i < numBytes; ++i)
+			word |= static_cast<std::uint64_t>(bytes[i]) << (i * 8);
+	}
+
+	myScratch		|= (word & LowBitMask(numBytes * 8)) << myScratchBits;
+	myScratchBits	+= numBytes * 8;
+	myOffset		+= numBytes;
+}
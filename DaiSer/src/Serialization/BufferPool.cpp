@@ -0,0 +1,258 @@
+#include <DaiSer/Serialization/BufferPool.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+using namespace DaiSer;
+
+namespace
+{
+	constexpr std::uint32_t NULL_INDEX				= UINT32_MAX;
+	constexpr std::size_t	STATS_FLUSH_INTERVAL	= 256;
+
+	/// Buffers shared between all threads. Slots are moved between two lock-free stacks, one of empty and one of
+	/// filled slots, and whoever pops a slot owns it until pushing it again. Stack heads pack a tag, bumped on
+	/// every change, next to the index of the top slot so that a slot that is popped and pushed back in between
+	/// is not mistaken for an unchanged stack.
+	/// 
+	class SharedCache
+	{
+	public:
+		SharedCache()
+		{
+			for (std::uint32_t i = 0; i < BufferPool::SHARED_CACHE_SIZE; ++i)
+				myNext[i].store(i + 1 < BufferPool::SHARED_CACHE_SIZE ? i + 1 : NULL_INDEX, std::memory_order_relaxed);
+
+			myEmptyHead.store(MakeHead(0, 0), std::memory_order_relaxed);
+			myFilledHead.store(MakeHead(NULL_INDEX, 0), std::memory_order_relaxed);
+		}
+
+		bool Push(ByteBuffer& aBuffer)
+		{
+			const std::uint32_t index = PopIndex(myEmptyHead);
+
+			if (index == NULL_INDEX)
+				return false;
+
+			mySlots[index] = std::move(aBuffer);
+			PushIndex(myFilledHead, index);
+
+			return true;
+		}
+
+		bool Pop(ByteBuffer& aOutBuffer)
+		{
+			const std::uint32_t index = PopIndex(myFilledHead);
+
+			if (index == NULL_INDEX)
+				return false;
+
+			aOutBuffer = std::move(mySlots[index]);
+			PushIndex(myEmptyHead, index);
+
+			return true;
+		}
+
+	private:
+		static std::uint64_t MakeHead(std::uint32_t aIndex, std::uint32_t aTag) noexcept
+		{
+			return (static_cast<std::uint64_t>(aTag) << 32) | aIndex;
+		}
+
+		std::uint32_t PopIndex(std::atomic<std::uint64_t>& aHead) noexcept
+		{
+			std::uint64_t head = aHead.load(std::memory_order_acquire);
+
+			for (;;)
+			{
+				const std::uint32_t index = static_cast<std::uint32_t>(head);
+
+				if (index == NULL_INDEX)
+					return NULL_INDEX;
+
+				const std::uint64_t next = MakeHead(myNext[index].load(std::memory_order_relaxed), static_cast<std::uint32_t>(head >> 32) + 1);
+
+				if (aHead.compare_exchange_weak(head, next, std::memory_order_acquire, std::memory_order_acquire))
+					return index;
+			}
+		}
+
+		void PushIndex(std::atomic<std::uint64_t>& aHead, std::uint32_t aIndex) noexcept
+		{
+			std::uint64_t head = aHead.load(std::memory_order_relaxed);
+			std::uint64_t next;
+
+			do
+			{
+				myNext[aIndex].store(static_cast<std::uint32_t>(head), std::memory_order_relaxed);
+				next = MakeHead(aIndex, static_cast<std::uint32_t>(head >> 32) + 1);
+			}
+			while (!aHead.compare_exchange_weak(head, next, std::memory_order_release, std::memory_order_relaxed));
+		}
+
+		std::array<ByteBuffer, BufferPool::SHARED_CACHE_SIZE>					mySlots;
+		std::array<std::atomic<std::uint32_t>, BufferPool::SHARED_CACHE_SIZE>	myNext;
+
+		alignas(64) std::atomic<std::uint64_t> myEmptyHead;
+		alignas(64) std::atomic<std::uint64_t> myFilledHead;
+	};
+
+	struct SharedStats
+	{
+		std::atomic<std::size_t>	numAcquired		= 0;
+		std::atomic<std::size_t>	numHits			= 0;
+		std::atomic<std::size_t>	numReleased		= 0;
+		std::atomic<std::size_t>	numDropped		= 0;
+		std::atomic<std::int64_t>	retainedBytes	= 0;
+	};
+
+	SharedCache& GetSharedCache()
+	{
+		static SharedCache cache;
+		return cache;
+	}
+
+	SharedStats& GetSharedStats()
+	{
+		static SharedStats stats;
+		return stats;
+	}
+
+	/// Buffers and counters of a single thread, counters are added to the shared ones in batches so that
+	/// threads do not contend on them
+	/// 
+	struct LocalCache
+	{
+		LocalCache()
+		{
+			(void)GetSharedCache(); // constructed first so that it is destroyed after the cache of the main thread
+			(void)GetSharedStats();
+		}
+
+		~LocalCache()
+		{
+			for (std::size_t i = 0; i < numBuffers; ++i)
+			{
+				if (!GetSharedCache().Push(buffers[i]))
+				{
+					retainedBytes -= static_cast<std::int64_t>(buffers[i].GetCapacity());
+					++numDropped;
+				}
+			}
+
+			FlushStats();
+		}
+
+		void CountOperation()
+		{
+			if (++numOperations == STATS_FLUSH_INTERVAL)
+				FlushStats();
+		}
+
+		void FlushStats()
+		{
+			SharedStats& stats = GetSharedStats();
+
+			stats.numAcquired.fetch_add(numAcquired, std::memory_order_relaxed);
+			stats.numHits.fetch_add(numHits, std::memory_order_relaxed);
+			stats.numReleased.fetch_add(numReleased, std::memory_order_relaxed);
+			stats.numDropped.fetch_add(numDropped, std::memory_order_relaxed);
+			stats.retainedBytes.fetch_add(retainedBytes, std::memory_order_relaxed);
+
+			numAcquired		= 0;
+			numHits			= 0;
+			numReleased		= 0;
+			numDropped		= 0;
+			retainedBytes	= 0;
+			numOperations	= 0;
+		}
+
+		std::array<ByteBuffer, BufferPool::LOCAL_CACHE_SIZE> buffers;
+		std::size_t numBuffers = 0;
+
+		std::size_t		numAcquired		= 0;
+		std::size_t		numHits			= 0;
+		std::size_t		numReleased		= 0;
+		std::size_t		numDropped		= 0;
+		std::int64_t	retainedBytes	= 0; // change since the last flush
+		std::size_t		numOperations	= 0;
+	};
+
+	thread_local LocalCache threadCache;
+}
+
+ByteBuffer BufferPool::Acquire(std::size_t aMinCapacity)
+{
+	LocalCache& local = threadCache;
+
+	ByteBuffer buffer;
+	bool isHit = true;
+
+	if (local.numBuffers != 0)
+		buffer = std::move(local.buffers[--local.numBuffers]);
+	else
+		isHit = GetSharedCache().Pop(buffer);
+
+	++local.numAcquired;
+
+	if (isHit)
+	{
+		++local.numHits;
+		local.retainedBytes -= static_cast<std::int64_t>(buffer.GetCapacity());
+	}
+
+	if (buffer.GetCapacity() < aMinCapacity)
+		buffer.Reserve(aMinCapacity);
+
+	local.CountOperation();
+
+	return buffer;
+}
+
+void BufferPool::Release(ByteBuffer&& aBuffer)
+{
+	LocalCache& local = threadCache;
+
+	ByteBuffer buffer = std::move(aBuffer);
+	buffer.Clear();
+
+	++local.numReleased;
+
+	const std::size_t capacity = buffer.GetCapacity();
+
+	if (capacity == 0 || capacity > MAX_BUFFER_CAPACITY)
+	{
+		++local.numDropped;
+	}
+	else if (local.numBuffers != LOCAL_CACHE_SIZE)
+	{
+		local.buffers[local.numBuffers++] = std::move(buffer);
+		local.retainedBytes += static_cast<std::int64_t>(capacity);
+	}
+	else if (GetSharedCache().Push(buffer))
+	{
+		local.retainedBytes += static_cast<std::int64_t>(capacity);
+	}
+	else
+	{
+		++local.numDropped;
+	}
+
+	local.CountOperation();
+}
+
+BufferPoolStats BufferPool::GetStats() noexcept
+{
+	const SharedStats& stats = GetSharedStats();
+
+	BufferPoolStats result;
+	result.numAcquired		= stats.numAcquired.load(std::memory_order_relaxed);
+	result.numHits			= stats.numHits.load(std::memory_order_relaxed);
+	result.numReleased		= stats.numReleased.load(std::memory_order_relaxed);
+	result.numDropped		= stats.numDropped.load(std::memory_order_relaxed);
+	result.retainedBytes	= static_cast<std::size_t>(std::max<std::int64_t>(0, stats.retainedBytes.load(std::memory_order_relaxed)));
+
+	return result;
+}
@@ -0,0 +1,201 @@
+#include <DaiSer/Serialization/Checksum.h>
+
+#include <DaiSer/Utility/BitUtils.hpp>
+#include <DaiSer/Utility/CpuFeatures.hpp>
+
+#include <array>
+#include <bit>
+#include <cstring>
+
+#define DAISER_HARDWARE_CRC32C DAISER_CPU_X64 // the 64-bit crc32 is only available in 64-bit mode
+
+using namespace DaiSer;
+
+namespace
+{
+	constexpr std::uint32_t POLYNOMIAL = 0x82F63B78u; // reflected Castagnoli polynomial
+
+#if DAISER_HARDWARE_CRC32C
+
+	constexpr std::size_t LONG_STRIDE	= 8192;
+	constexpr std::size_t SHORT_STRIDE	= 256;
+
+	using Matrix = std::array<std::uint32_t, 32>; // GF(2) operator on the register, one column per bit
+
+	constexpr std::uint32_t Multiply(const Matrix& aMatrix, std::uint32_t aVector)
+	{
+		std::uint32_t result = 0;
+
+		for (std::size_t i = 0; aVector != 0; ++i, aVector >>= 1)
+		{
+			if (aVector & 1)
+				result ^= aMatrix[i];
+		}
+
+		return result;
+	}
+
+	constexpr Matrix Square(const Matrix& aMatrix)
+	{
+		Matrix result{};
+
+		for (std::size_t i = 0; i < result.size(); ++i)
+			result[i] = Multiply(aMatrix, aMatrix[i]);
+
+		return result;
+	}
+
+	/// Lookup tables for advancing the register over aNumBytes zero bytes, aNumBytes must be a power of two,
+	/// which is what allows the separately computed streams to be combined
+	/// 
+	constexpr std::array<std::array<std::uint32_t, 256>, 4> MakeShiftTable(std::size_t aNumBytes)
+	{
+		Matrix op{}; // a single zero bit
+
+		op[0] = POLYNOMIAL;
+		for (std::size_t i = 1; i < op.size(); ++i)
+			op[i] = std::uint32_t(1) << (i - 1);
+
+		for (std::size_t numBits = 1; numBits < aNumBytes * 8; numBits *= 2)
+			op = Square(op);
+
+		std::array<std::array<std::uint32_t, 256>, 4> table{};
+
+		for (std::uint32_t i = 0; i < 256; ++i)
+		{
+			for (std::uint32_t k = 0; k < 4; ++k)
+				table[k][i] = Multiply(op, i << (8 * k));
+		}
+
+		return table;
+	}
+
+	constexpr auto LONG_SHIFT	= MakeShiftTable(LONG_STRIDE);
+	constexpr auto SHORT_SHIFT	= MakeShiftTable(SHORT_STRIDE);
+
+	std::uint32_t Shift(const std::array<std::array<std::uint32_t, 256>, 4>& aTable, std::uint32_t aCrc) noexcept
+	{
+		return aTable[0][aCrc & 0xFF] ^ aTable[1][(aCrc >> 8) & 0xFF] ^ aTable[2][(aCrc >> 16) & 0xFF] ^ aTable[3][aCrc >> 24];
+	}
+
+	std::uint64_t Load64(const std::byte* aData) noexcept
+	{
+		std::uint64_t value;
+		std::memcpy(&value, aData, sizeof(value));
+
+		return value;
+	}
+
+	/// Checksums three adjacent strides at once and merges them, the crc32 instruction has a latency
+	/// of three cycles but can start every cycle
+	/// 
+	template<std::size_t Stride>
+	DAISER_TARGET("sse4.2") std::uint32_t UpdateStrides(std::uint32_t aCrc, const std::byte*& aData, std::size_t& aNumBytes, const std::array<std::array<std::uint32_t, 256>, 4>& aShift) noexcept
+	{
+		std::uint64_t crc0 = aCrc;
+
+		for (; aNumBytes >= 3 * Stride; aData += 3 * Stride, aNumBytes -= 3 * Stride)
+		{
+			std::uint64_t crc1 = 0;
+			std::uint64_t crc2 = 0;
+
+			for (std::size_t i = 0; i < Stride; i += 8)
+			{
+				crc0 = _mm_crc32_u64(crc0, Load64(aData + i));
+				crc1 = _mm_crc32_u64(crc1, Load64(aData + i + Stride));
+				crc2 = _mm_crc32_u64(crc2, Load64(aData + i + 2 * Stride));
+			}
+
+			crc0 = Shift(aShift, static_cast<std::uint32_t>(crc0)) ^ crc1;
+			crc0 = Shift(aShift, static_cast<std::uint32_t>(crc0)) ^ crc2;
+		}
+
+		return static_cast<std::uint32_t>(crc0);
+	}
+
+	DAISER_TARGET("sse4.2") std::uint32_t UpdateHardware(std::uint32_t aCrc, const std::byte* aData, std::size_t aNumBytes) noexcept
+	{
+		aCrc = UpdateStrides<LONG_STRIDE>(aCrc, aData, aNumBytes, LONG_SHIFT);
+		aCrc = UpdateStrides<SHORT_STRIDE>(aCrc, aData, aNumBytes, SHORT_SHIFT);
+
+		std::uint64_t crc = aCrc;
+		for (; aNumBytes >= 8; aData += 8, aNumBytes -= 8)
+			crc = _mm_crc32_u64(crc, Load64(aData));
+
+		aCrc = static_cast<std::uint32_t>(crc);
+		for (; aNumBytes != 0; ++aData, --aNumBytes)
+			aCrc = _mm_crc32_u8(aCrc, static_cast<std::uint8_t>(*aData));
+
+		return aCrc;
+	}
+
+#endif
+
+	using Table = std::array<std::array<std::uint32_t, 256>, 8>;
+
+	/// Table k advances a byte followed by k zero bytes through the register
+	/// 
+	constexpr Table MakeSlicingTable()
+	{
+		Table table{};
+
+		for (std::uint32_t i = 0; i < 256; ++i)
+		{
+			std::uint32_t crc = i;
+			for (int bit = 0; bit < 8; ++bit)
+				crc = (crc >> 1) ^ ((crc & 1) ? POLYNOMIAL : 0);
+
+			table[0][i] = crc;
+		}
+
+		for (std::size_t k = 1; k < table.size(); ++k)
+		{
+			for (std::uint32_t i = 0; i < 256; ++i)
+				table[k][i] = (table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xFF];
+		}
+
+		return table;
+	}
+
+	constexpr Table SLICING_TABLE = MakeSlicingTable();
+
+	std::uint32_t UpdateSoftware(std::uint32_t aCrc, const std::byte* aData, std::size_t aNumBytes) noexcept
+	{
+		for (; aNumBytes >= 8; aData += 8, aNumBytes -= 8)
+		{
+			std::uint32_t low, high;
+			std::memcpy(&low, aData, 4);
+			std::memcpy(&high, aData + 4, 4);
+
+			if constexpr (std::endian::native == std::endian::big)
+			{
+				low		= ByteSwap(low);
+				high	= ByteSwap(high);
+			}
+
+			low ^= aCrc;
+
+			aCrc =	SLICING_TABLE[7][low & 0xFF]			^ SLICING_TABLE[6][(low >> 8) & 0xFF] ^
+					SLICING_TABLE[5][(low >> 16) & 0xFF]	^ SLICING_TABLE[4][low >> 24] ^
+					SLICING_TABLE[3][high & 0xFF]			^ SLICING_TABLE[2][(high >> 8) & 0xFF] ^
+					SLICING_TABLE[1][(high >> 16) & 0xFF]	^ SLICING_TABLE[0][high >> 24];
+		}
+
+		for (; aNumBytes != 0; ++aData, --aNumBytes)
+			aCrc = (aCrc >> 8) ^ SLICING_TABLE[0][(aCrc ^ static_cast<std::uint8_t>(*aData)) & 0xFF];
+
+		return aCrc;
+	}
+}
+
+std::uint32_t DaiSer::Crc32c(std::span<const std::byte> aBytes, std::uint32_t aCrc) noexcept
+{
+	const std::uint32_t crc = ~aCrc;
+
+#if DAISER_HARDWARE_CRC32C
+	if (GetCpuFeatures().sse42) // builds for x86-64 do not assume SSE4.2
+		return ~UpdateHardware(crc, aBytes.data(), aBytes.size());
+#endif
+
+	return ~UpdateSoftware(crc, aBytes.data(), aBytes.size());
+}
@@ -0,0 +1,144 @@
+#include <DaiSer/Serialization/ColumnarVector.h>
+
+#include <DaiSer/Utility/CpuFeatures.hpp>
+
+#include <cstdint>
+#include <algorithm>
+
+using namespace DaiSer;
+
+namespace
+{
+	/// Bytes of rows per block, small enough that a block stays in the L1 cache while it is transposed
+	/// 
+	constexpr std::size_t BLOCK_BYTES = 16 * 1024;
+
+	/// Strides up to this fit the 32-bit lane offsets of the gather instructions for every lane
+	/// 
+	constexpr std::size_t MAX_GATHER_STRIDE = INT32_MAX / 8;
+
+#if DAISER_CPU_X64
+
+	/// Gathers whole vectors of 4 or 8-byte values, returns the number of values gathered
+	/// 
+	template<std::size_t Size>
+	DAISER_TARGET("avx2") std::size_t GatherValuesAVX2(std::byte* aOut, const std::byte* aIn, std::size_t aStride, std::size_t aNumValues) noexcept
+	{
+		const int stride = static_cast<int>(aStride);
+
+		std::size_t i = 0;
+
+		if constexpr (Size == 4)
+		{
+			const __m256i indices = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(stride));
+
+			for (; aNumValues - i >= 8; i += 8)
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(aOut + i * Size), _mm256_i32gather_epi32(reinterpret_cast<const int*>(aIn + i * aStride), indices, 1));
+		}
+		else
+		{
+			const __m128i indices = _mm_mullo_epi32(_mm_setr_epi32(0, 1, 2, 3), _mm_set1_epi32(stride));
+
+			for (; aNumValues - i >= 4; i += 4)
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(aOut + i * Size), _mm256_i32gather_epi64(reinterpret_cast<const long long*>(aIn + i * aStride), indices, 1));
+		}
+
+		return i;
+	}
+
+#endif
+
+	/// Values of 4 and 8 bytes are gathered a vector at a time where the processor supports AVX2, other sizes
+	/// and the remainder are fixed-size copies that compile to a single load and store. Scattering stays
+	/// scalar, the AVX-512 scatter instructions are no faster than separate stores.
+	/// 
+	template<std::size_t Size>
+	void GatherValues(std::byte* aOut, const std::byte* aIn, std::size_t aStride, std::size_t aNumValues) noexcept
+	{
+		std::size_t i = 0;
+#if DAISER_CPU_X64
+		if constexpr (Size == 4 || Size == 8)
+		{
+			if (aStride <= MAX_GATHER_STRIDE && GetCpuFeatures().avx2)
+				i = GatherValuesAVX2<Size>(aOut, aIn, aStride, aNumValues);
+		}
+#endif
+		for (; i < aNumValues; ++i)
+			std::memcpy(aOut + i * Size, aIn + i * aStride, Size);
+	}
+
+	template<std::size_t Size>
+	void ScatterValues(std::byte* aOut, const std::byte* aIn, std::size_t aStride, std::size_t aNumValues) noexcept
+	{
+		for (std::size_t i = 0; i < aNumValues; ++i)
+			std::memcpy(aOut + i * aStride, aIn + i * Size, Size);
+	}
+
+	void GatherValues(std::byte* aOut, const std::byte* aIn, std::size_t aStride, std::size_t aNumValues, std::size_t aSize) noexcept
+	{
+		switch (aSize)
+		{
+		case 1:		GatherValues<1>(aOut, aIn, aStride, aNumValues); break;
+		case 2:		GatherValues<2>(aOut, aIn, aStride, aNumValues); break;
+		case 4:		GatherValues<4>(aOut, aIn, aStride, aNumValues); break;
+		case 8:		GatherValues<8>(aOut, aIn, aStride, aNumValues); break;
+		case 16:	GatherValues<16>(aOut, aIn, aStride, aNumValues); break;
+		default:
+			for (std::size_t i = 0; i < aNumValues; ++i)
+				std::memcpy(aOut + i * aSize, aIn + i * aStride, aSize);
+			break;
+		}
+	}
+
+	void ScatterValues(std::byte* aOut, const std::byte* aIn, std::size_t aStride, std::size_t aNumValues, std::size_t aSize) noexcept
+	{
+		switch (aSize)
+		{
+		case 1:		ScatterValues<1>(aOut, aIn, aStride, aNumValues); break;
+		case 2:		ScatterValues<2>(aOut, aIn, aStride, aNumValues); break;
+		case 4:		ScatterValues<4>(aOut, aIn, aStride, aNumValues); break;
+		case 8:		ScatterValues<8>(aOut, aIn, aStride, aNumValues); break;
+		case 16:	ScatterValues<16>(aOut, aIn, aStride, aNumValues); break;
+		default:
+			for (std::size_t i = 0; i < aNumValues; ++i)
+				std::memcpy(aOut + i * aStride, aIn + i * aSize, aSize);
+			break;
+		}
+	}
+}
+
+void DaiSer::GatherColumns(std::span<const ColumnLayout> aLayouts, const std::byte* aRows, std::size_t aRowSize, std::size_t aNumRows, std::byte* aOutColumns) noexcept
+{
+	const std::size_t blockRows = std::max<std::size_t>(1, BLOCK_BYTES / aRowSize);
+
+	for (std::size_t first = 0; first < aNumRows; first += blockRows)
+	{
+		const std::size_t numValues = std::min(blockRows, aNumRows - first);
+
+		std::byte* column = aOutColumns;
+
+		for (const ColumnLayout& layout : aLayouts)
+		{
+			GatherValues(column + first * layout.memberSize, aRows + first * aRowSize + layout.memberOffset, aRowSize, numValues, layout.memberSize);
+			column += layout.memberSize * aNumRows;
+		}
+	}
+}
+
+void DaiSer::ScatterColumns(std::span<const ColumnLayout> aLayouts, const std::byte* aColumns, std::size_t aNumRows, std::byte* aOutRows, std::size_t aRowSize) noexcept
+{
+	const std::size_t blockRows = std::max<std::size_t>(1, BLOCK_BYTES / aRowSize);
+
+	for (std::size_t first = 0; first < aNumRows; first += blockRows)
+	{
+		const std::size_t numValues = std::min(blockRows, aNumRows - first);
+
+		const std::byte* column = aColumns;
+
+		for (const ColumnLayout& layout : aLayouts)
+		{
+			ScatterValues(aOutRows + first * aRowSize + layout.memberOffset, column + first * layout.memberSize, aRowSize, numValues, layout.memberSize);
+			column += layout.memberSize * aNumRows;
+		}
+	}
+}
@@ -0,0 +1,417 @@
+#include <DaiSer/Serialization/Compression.h>
+
+#include <DaiSer/Utility/BitUtils.hpp>
+
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+using namespace DaiSer;
+
+namespace
+{
+	// LZ4-style sequences: a token with the literal length in the high and the match length in the low
+	// nibble, extra length bytes for nibbles that are maxed out, the literals, and a 16-bit match offset.
+	// The last sequence of a block only has literals.
+
+	constexpr std::uint32_t HASH_BITS		= 14;
+	constexpr std::size_t	MIN_MATCH		= 4;
+	constexpr std::size_t	MAX_OFFSET		= 65535;
+	constexpr std::size_t	LAST_LITERALS	= 8;	// matches stop this far from the end so that their extension can load 8 bytes
+	constexpr std::size_t	MATCH_LIMIT		= 12;	// no match starts this close to the end
+	constexpr std::uint32_t	SKIP_TRIGGER	= 6;	// step further ahead the longer no match has been found
+
+	constexpr std::uint32_t STORED_FLAG	= 0x80000000u;
+
+	constexpr std::size_t	COPY_SLACK			= 16;	// matches are copied 8 bytes at a time and may write this far past their end
+	constexpr std::size_t	MAX_EXPANSION		= 256;	// bounds the up front allocation for corrupt headers
+	constexpr std::size_t	ENTROPY_SAMPLES		= 1 << 14;
+	constexpr double		ENTROPY_BYPASS_BITS	= 7.9;	// bits per byte above which blocks are stored as-is
+
+	std::uint32_t Load32(const std::byte* aIn) noexcept
+	{
+		std::uint32_t value;
+		std::memcpy(&value, aIn, sizeof(value));
+
+		return value;
+	}
+
+	std::uint64_t Load64(const std::byte* aIn) noexcept
+	{
+		std::uint64_t value;
+		std::memcpy(&value, aIn, sizeof(value));
+
+		return value;
+	}
+
+	std::uint32_t LoadLE32(const std::byte* aIn) noexcept
+	{
+		const std::uint32_t value = Load32(aIn);
+		return std::endian::native == std::endian::little ? value : ByteSwap(value);
+	}
+
+	void StoreLE32(std::byte* aOut, std::uint32_t aValue) noexcept
+	{
+		if constexpr (std::endian::native == std::endian::big)
+			aValue = ByteSwap(aValue);
+
+		std::memcpy(aOut, &aValue, sizeof(aValue));
+	}
+
+	std::uint32_t Hash(std::uint32_t aValue, std::uint32_t aHashBits) noexcept
+	{
+		return (aValue * 2654435761u) >> (32 - aHashBits);
+	}
+
+	/// Estimates the order-0 entropy from an evenly spread sample of the bytes
+	/// 
+	double EstimateEntropy(std::span<const std::byte> aInput) noexcept
+	{
+		std::array<std::uint32_t, 256> histogram{};
+
+		const std::size_t step = std::max<std::size_t>(1, aInput.size() / ENTROPY_SAMPLES);
+
+		std::size_t numSamples = 0;
+		for (std::size_t i = 0; i < aInput.size(); i += step, ++numSamples)
+			++histogram[static_cast<std::uint8_t>(aInput[i])];
+
+		double entropy = 0.0;
+		for (const std::uint32_t count : histogram)
+		{
+			if (count != 0)
+			{
+				const double probability = static_cast<double>(count) / static_cast<double>(numSamples);
+				entropy -= probability * std::log2(probability);
+			}
+		}
+
+		return entropy;
+	}
+
+	std::byte* WriteLengthBytes(std::byte* aOut, std::size_t aLength) noexcept
+	{
+		for (; aLength >= 255; aLength -= 255)
+			*aOut++ = std::byte(255);
+
+		*aOut++ = static_cast<std::byte>(aLength);
+
+		return aOut;
+	}
+
+	/// Copies short runs with a single fixed-size copy, which may read and write up to COPY_SLACK bytes past them
+	/// 
+	void CopyLiterals(std::byte* aOut, const std::byte* aIn, std::size_t aNumBytes, bool aCanOverread) noexcept
+	{
+		if (aNumBytes <= COPY_SLACK && aCanOverread)
+			std::memcpy(aOut, aIn, COPY_SLACK);
+		else
+			std::memcpy(aOut, aIn, aNumBytes);
+	}
+
+	std::byte* WriteSequence(std::byte* aOut, const std::byte* aLiterals, std::size_t aNumLiterals, std::size_t aMatchLength, std::size_t aOffset, bool aCanOverread) noexcept
+	{
+		std::byte* token = aOut++;
+
+		const std::size_t literalNibble	= std::min<std::size_t>(aNumLiterals, 15);
+		const std::size_t matchNibble	= std::min<std::size_t>(aMatchLength, 15);
+
+		*token = static_cast<std::byte>((literalNibble << 4) | matchNibble);
+
+		if (literalNibble == 15)
+			aOut = WriteLengthBytes(aOut, aNumLiterals - 15);
+
+		CopyLiterals(aOut, aLiterals, aNumLiterals, aCanOverread);
+		aOut += aNumLiterals;
+
+		if (aOffset == 0) // last sequence
+			return aOut;
+
+		*aOut++ = static_cast<std::byte>(aOffset & 0xFF);
+		*aOut++ = static_cast<std::byte>(aOffset >> 8);
+
+		if (matchNibble == 15)
+			aOut = WriteLengthBytes(aOut, aMatchLength - 15);
+
+		return aOut;
+	}
+
+	/// Returns the number of bytes written, which may be as many as the bound plus COPY_SLACK
+	/// 
+	std::size_t CompressSequences(std::span<const std::byte> aInput, std::byte* aOut) noexcept
+	{
+		const std::byte* const begin = aInput.data();
+		const std::size_t numBytes = aInput.size();
+
+		// small blocks use part of the table so that clearing it does not dominate
+		const std::uint32_t hashBits = std::clamp<std::uint32_t>(static_cast<std::uint32_t>(std::bit_width(numBytes)), 8, HASH_BITS);
+
+		thread_local std::array<std::uint32_t, std::size_t(1) << HASH_BITS> table;
+		std::fill_n(table.begin(), std::size_t(1) << hashBits, 0);
+
+		std::byte* out = aOut;
+
+		std::size_t position	= 1;
+		std::size_t anchor		= 0;
+
+		if (numBytes > MATCH_LIMIT)
+		{
+			const std::size_t matchLimit	= numBytes - MATCH_LIMIT;
+			const std::size_t extendLimit	= numBytes - LAST_LITERALS;
+
+			table[Hash(Load32(begin), hashBits)] = 0;
+
+			while (position < matchLimit)
+			{
+				const std::uint32_t value = Load32(begin + position);
+				const std::uint32_t hash = Hash(value, hashBits);
+
+				std::size_t candidate = table[hash];
+				table[hash] = static_cast<std::uint32_t>(position);
+
+				if (position - candidate > MAX_OFFSET || Load32(begin + candidate) != value)
+				{
+					position += 1 + ((position - anchor) >> SKIP_TRIGGER);
+					continue;
+				}
+
+				// extend backwards over literals that are also part of the match
+				while (position > anchor && candidate > 0 && begin[position - 1] == begin[candidate - 1])
+				{
+					--position;
+					--candidate;
+				}
+
+				std::size_t length = MIN_MATCH;
+				while (position + length + sizeof(std::uint64_t) <= extendLimit)
+				{
+					const std::uint64_t difference = Load64(begin + position + length) ^ Load64(begin + candidate + length);
+
+					if (difference != 0)
+					{
+						length += (std::endian::native == std::endian::little ? std::countr_zero(difference) : std::countl_zero(difference)) / 8;
+						goto found;
+					}
+
+					length += sizeof(std::uint64_t);
+				}
+
+				while (position + length < extendLimit && begin[position + length] == begin[candidate + length])
+					++length;
+
+			found:
+				out = WriteSequence(out, begin + anchor, position - anchor, length - MIN_MATCH, position - candidate, anchor + COPY_SLACK <= numBytes);
+
+				position += length;
+				anchor = position;
+
+				if (position - 2 < matchLimit) // helps the next match to be found
+					table[Hash(Load32(begin + position - 2), hashBits)] = static_cast<std::uint32_t>(position - 2);
+			}
+		}
+
+		return static_cast<std::size_t>(WriteSequence(out, begin + anchor, numBytes - anchor, 0, 0, false) - aOut);
+	}
+
+	[[noreturn]] void ThrowCorrupt()
+	{
+		throw std::runtime_error("Compressed block is corrupt");
+	}
+
+	std::size_t ReadLengthBytes(const std::byte*& aIn, const std::byte* aEnd)
+	{
+		std::size_t length = 0;
+
+		for (;;)
+		{
+			if (aIn == aEnd)
+				ThrowCorrupt();
+
+			const std::uint8_t value = static_cast<std::uint8_t>(*aIn++);
+			length += value;
+
+			if (value != 255)
+				return length;
+		}
+	}
+
+	/// aOut has at least COPY_SLACK bytes of room past aOutEnd
+	/// 
+	void DecompressSequences(std::span<const std::byte> aInput, std::byte* aOut, std::byte* aOutEnd)
+	{
+		const std::byte* in			= aInput.data();
+		const std::byte* const end	= in + aInput.size();
+
+		std::byte* out = aOut;
+
+		for (;;)
+		{
+			if (in == end)
+				ThrowCorrupt();
+
+			const std::uint8_t token = static_cast<std::uint8_t>(*in++);
+
+			std::size_t numLiterals = token >> 4;
+			if (numLiterals == 15)
+				numLiterals += ReadLengthBytes(in, end);
+
+			if (numLiterals > static_cast<std::size_t>(end - in) || numLiterals > static_cast<std::size_t>(aOutEnd - out))
+				ThrowCorrupt();
+
+			CopyLiterals(out, in, numLiterals, static_cast<std::size_t>(end - in) >= COPY_SLACK);
+
+			in	+= numLiterals;
+			out += numLiterals;
+
+			if (in == end) // last sequence
+				break;
+
+			if (end - in < 2)
+				ThrowCorrupt();
+
+			const std::size_t offset = static_cast<std::size_t>(in[0]) | (static_cast<std::size_t>(in[1]) << 8);
+			in += 2;
+
+			std::size_t length = token & 15;
+			if (length == 15)
+				length += ReadLengthBytes(in, end);
+
+			length += MIN_MATCH;
+
+			if (offset == 0 || offset > static_cast<std::size_t>(out - aOut) || length > static_cast<std::size_t>(aOutEnd - out))
+				ThrowCorrupt();
+
+			const std::byte* match = out - offset;
+
+			// short offsets repeat a pattern, e.g., runs of the same byte, which is copied from a whole
+			// number of patterns back so that every 8-byte copy reads bytes that are already written
+			const std::size_t distance = (offset >= sizeof(std::uint64_t)) ? offset : offset * ((sizeof(std::uint64_t) + offset - 1) / offset);
+
+			std::size_t i = 0;
+			for (const std::size_t numBytes = std::min(length, distance - offset); i < numBytes; ++i)
+				out[i] = match[i];
+
+			for (; i < length; i += sizeof(std::uint64_t)) // may run past the match into the slack
+				std::memcpy(out + i, out + i - distance, sizeof(std::uint64_t));
+
+			out += length;
+		}
+
+		if (out != aOutEnd)
+			ThrowCorrupt();
+	}
+}
+
+std::size_t DaiSer::CompressBound(std::size_t aNumBytes, std::size_t aBlockSize)
+{
+	const std::size_t numBlocks = std::max<std::size_t>(1, (aNumBytes + aBlockSize - 1) / aBlockSize);
+	return aNumBytes + numBlocks * COMPRESSION_BLOCK_HEADER_SIZE;
+}
+
+std::size_t DaiSer::CompressBlock(std::span<const std::byte> aInput, ByteBuffer& aOutBuffer, std::size_t aOffset)
+{
+	assert(aInput.size() <= MAX_COMPRESSION_BLOCK_SIZE && "Block is too large!");
+
+	const std::size_t numBytes = aInput.size();
+
+	// worst case of the sequences, a literal length byte for every 255 literals and the token
+	const std::size_t sequenceBound = numBytes + numBytes / 255 + 16;
+
+	std::byte* header = aOutBuffer.Prepare(aOffset, COMPRESSION_BLOCK_HEADER_SIZE + sequenceBound + COPY_SLACK);
+	std::byte* data = header + COMPRESSION_BLOCK_HEADER_SIZE;
+
+	std::size_t storedBytes = numBytes;
+	bool isCompressed = false;
+
+	if (numBytes != 0 && EstimateEntropy(aInput) < ENTROPY_BYPASS_BITS)
+	{
+		const std::size_t compressedBytes = CompressSequences(aInput, data);
+
+		if (compressedBytes < numBytes)
+		{
+			storedBytes = compressedBytes;
+			isCompressed = true;
+		}
+	}
+
+	if (!isCompressed && numBytes != 0)
+		std::memcpy(data, aInput.data(), numBytes);
+
+	StoreLE32(header, static_cast<std::uint32_t>(storedBytes) | (isCompressed ? 0 : STORED_FLAG));
+	StoreLE32(header + 4, static_cast<std::uint32_t>(numBytes));
+
+	aOutBuffer.Resize(aOffset + COMPRESSION_BLOCK_HEADER_SIZE + storedBytes);
+
+	return COMPRESSION_BLOCK_HEADER_SIZE + storedBytes;
+}
+
+std::size_t DaiSer::DecompressBlock(std::span<const std::byte> aInput, ByteBuffer& aOutBuffer, std::size_t& aInOutOffset)
+{
+	if (aInput.size() < COMPRESSION_BLOCK_HEADER_SIZE)
+		ThrowCorrupt();
+
+	const std::uint32_t storedWord	= LoadLE32(aInput.data());
+	const std::size_t storedBytes	= storedWord & ~STORED_FLAG;
+	const std::size_t numBytes		= LoadLE32(aInput.data() + 4);
+
+	if (storedBytes > aInput.size() - COMPRESSION_BLOCK_HEADER_SIZE || numBytes > MAX_COMPRESSION_BLOCK_SIZE)
+		ThrowCorrupt();
+
+	const std::span<const std::byte> data = aInput.subspan(COMPRESSION_BLOCK_HEADER_SIZE, storedBytes);
+
+	std::byte* out = aOutBuffer.Prepare(aInOutOffset, numBytes + COPY_SLACK);
+
+	if ((storedWord & STORED_FLAG) != 0)
+	{
+		if (storedBytes != numBytes)
+			ThrowCorrupt();
+
+		if (numBytes != 0)
+			std::memcpy(out, data.data(), numBytes);
+	}
+	else
+	{
+		DecompressSequences(data, out, out + numBytes);
+	}
+
+	aInOutOffset += numBytes;
+	aOutBuffer.Resize(aInOutOffset);
+
+	return COMPRESSION_BLOCK_HEADER_SIZE + storedBytes;
+}
+
+ByteBuffer DaiSer::Compress(std::span<const std::byte> aInput, std::size_t aBlockSize)
+{
+	assert(aBlockSize != 0 && aBlockSize <= MAX_COMPRESSION_BLOCK_SIZE && "Invalid block size!");
+
+	ByteBuffer result(CompressBound(aInput.size(), aBlockSize));
+
+	std::size_t offset = 0;
+	for (std::size_t i = 0; i < aInput.size(); i += aBlockSize)
+		offset += CompressBlock(aInput.subspan(i, std::min(aBlockSize, aInput.size() - i)), result, offset);
+
+	return result;
+}
+
+ByteBuffer DaiSer::Decompress(std::span<const std::byte> aInput)
+{
+	// the headers give the decompressed size up front, so the result is allocated once
+	std::size_t numBytes = 0;
+	for (std::size_t i = 0; i + COMPRESSION_BLOCK_HEADER_SIZE <= aInput.size(); )
+	{
+		numBytes	+= LoadLE32(aInput.data() + i + 4);
+		i			+= COMPRESSION_BLOCK_HEADER_SIZE + (LoadLE32(aInput.data() + i) & ~STORED_FLAG);
+	}
+
+	ByteBuffer result(std::min(numBytes, aInput.size() * MAX_EXPANSION) + COPY_SLACK);
+
+	std::size_t offset = 0;
+	for (std::size_t i = 0; i < aInput.size(); )
+		i += DecompressBlock(aInput.subspan(i), result, offset);
+
+	return result;
+}
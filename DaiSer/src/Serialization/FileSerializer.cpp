@@ -0,0 +1,129 @@
+#include <DaiSer/Serialization/FileSerializer.h>
+
+#include <stdexcept>
+#include <string>
+
+using namespace DaiSer;
+
+FileSink::FileSink(const std::filesystem::path& aPath, std::size_t aChunkSize)
+	: myChunk(aChunkSize)
+	, myChunkSize(aChunkSize)
+{
+#ifdef DAISER_SYSTEM_WIN
+	myFile = _wfopen(aPath.c_str(), L"wb");
+#else
+	myFile = std::fopen(aPath.c_str(), "wb");
+#endif
+
+	if (myFile == nullptr)
+		throw std::runtime_error("FileSink: could not open " + aPath.string());
+
+	std::setvbuf(myFile, nullptr, _IONBF, 0); // the chunk is the buffer, avoid copying everything twice
+}
+
+FileSink::~FileSink()
+{
+	try
+	{
+		Close();
+	}
+	catch (...)
+	{
+
+	}
+}
+
+void FileSink::Flush()
+{
+	WriteToFile(myChunk.GetData(), myChunk.GetSize());
+
+	myChunkOffset += myChunk.GetSize();
+	myChunk.Clear();
+}
+
+void FileSink::Close()
+{
+	if (myFile == nullptr)
+		return;
+
+	Flush();
+
+	const int result = std::fclose(myFile);
+	myFile = nullptr;
+
+	if (result != 0)
+		throw std::runtime_error("FileSink: could not close the file");
+}
+
+void FileSink::Spill(std::size_t aOffset)
+{
+	// everything before the offset is final and can be written out
+	const std::size_t numFinal	= std::min(aOffset - myChunkOffset, myChunk.GetSize());
+	const std::size_t numKept	= myChunk.GetSize() - numFinal;
+
+	WriteToFile(myChunk.GetData(), numFinal);
+
+	if (myChunk.GetCapacity() > myChunkSize && numKept <= myChunkSize) // give back memory from an oversized write
+	{
+		ByteBuffer chunk(myChunkSize);
+		chunk.Resize(numKept);
+
+		if (numKept != 0)
+			std::memcpy(chunk.GetData(), myChunk.GetData() + numFinal, numKept);
+
+		myChunk = std::move(chunk);
+	}
+	else
+	{
+		if (numKept != 0)
+			std::memmove(myChunk.GetData(), myChunk.GetData() + numFinal, numKept);
+
+		myChunk.Resize(numKept);
+	}
+
+	myChunkOffset += numFinal;
+}
+
+void FileSink::Write(std::size_t aOffset, const std::byte* aData, std::size_t aNumBytes)
+{
+	if (aNumBytes >= myChunkSize)
+	{
+		Spill(aOffset);
+
+		if (myChunk.IsEmpty() && myChunkOffset == aOffset) // nothing is held after the offset, the bytes can skip the chunk
+		{
+			WriteToFile(aData, aNumBytes);
+			myChunkOffset += aNumBytes;
+
+			return;
+		}
+	}
+
+	if (aNumBytes != 0)
+		std::memcpy(Prepare(aOffset, aNumBytes), aData, aNumBytes);
+}
+
+void FileSink::WriteToFile(const std::byte* aData, std::size_t aNumBytes)
+{
+	assert(myFile != nullptr && "File has already been closed!");
+
+	if (aNumBytes != 0 && std::fwrite(aData, 1, aNumBytes, myFile) != aNumBytes)
+		throw std::runtime_error("FileSink: could not write to the file");
+}
+
+FileWriteSerializer::FileWriteSerializer(const std::filesystem::path& aPath, std::size_t aChunkSize)
+	: Serializer(SerializerState::Write)
+	, mySink(aPath, aChunkSize)
+{
+
+}
+
+void FileWriteSerializer::Flush()
+{
+	mySink.Flush();
+}
+
+void FileWriteSerializer::Close()
+{
+	mySink.Close();
+}
@@ -0,0 +1,66 @@
+#include <DaiSer/Serialization/IncrementalReader.h>
+
+#include <cstring>
+#include <utility>
+
+using namespace DaiSer;
+
+DecodeTask::DecodeTask(DecodeTask&& aOther) noexcept
+	: myHandle(std::exchange(aOther.myHandle, {}))
+{
+
+}
+
+DecodeTask& DecodeTask::operator=(DecodeTask&& aOther) noexcept
+{
+	if (this != &aOther)
+	{
+		if (myHandle)
+			myHandle.destroy();
+
+		myHandle = std::exchange(aOther.myHandle, {});
+	}
+
+	return *this;
+}
+
+DecodeTask::~DecodeTask()
+{
+	if (myHandle)
+		myHandle.destroy();
+}
+
+bool DecodeTask::IsDone() const
+{
+	if (!myHandle || !myHandle.done())
+		return false;
+
+	if (myHandle.promise().exception)
+		std::rethrow_exception(myHandle.promise().exception);
+
+	return true;
+}
+
+void IncrementalReader::Feed(std::span<const std::byte> aBytes)
+{
+	if (myOffset != 0 && myOffset >= myBuffer.GetSize() / 2) // decoded bytes are dropped once they make up half the buffer, so that it stops growing
+	{
+		const std::size_t numRemaining = myBuffer.GetSize() - myOffset;
+
+		std::memmove(myBuffer.GetData(), myBuffer.GetData() + myOffset, numRemaining);
+		myBuffer.Resize(numRemaining);
+
+		myOffset = 0;
+	}
+
+	if (!aBytes.empty())
+		std::memcpy(myBuffer.Prepare(myBuffer.GetSize(), aBytes.size()), aBytes.data(), aBytes.size());
+
+	if (!myWaiter || !myPendingProgress(*this, myPendingData))
+		return;
+
+	myPendingData		= nullptr;
+	myPendingProgress	= nullptr;
+
+	std::exchange(myWaiter, {}).resume(); // runs the task until the next value whose bytes have not arrived
+}
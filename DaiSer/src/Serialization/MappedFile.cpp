@@ -0,0 +1,143 @@
+#include <DaiSer/Serialization/MappedFile.h>
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#ifdef DAISER_SYSTEM_WIN
+#	define WIN32_LEAN_AND_MEAN
+#	include <Windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+using namespace DaiSer;
+
+MappedFile::MappedFile(const std::filesystem::path& aPath)
+{
+#ifdef DAISER_SYSTEM_WIN
+	myFileHandle = CreateFileW(aPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (myFileHandle == INVALID_HANDLE_VALUE)
+	{
+		myFileHandle = nullptr;
+		throw std::runtime_error("MappedFile: could not open " + aPath.string());
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(myFileHandle, &fileSize))
+	{
+		Close();
+		throw std::runtime_error("MappedFile: could not get the size of " + aPath.string());
+	}
+
+	mySize = static_cast<std::size_t>(fileSize.QuadPart);
+
+	if (mySize == 0) // empty files cannot be mapped
+		return;
+
+	myMappingHandle = CreateFileMappingW(myFileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (myMappingHandle == nullptr)
+	{
+		Close();
+		throw std::runtime_error("MappedFile: could not map " + aPath.string());
+	}
+
+	myData = static_cast<const std::byte*>(MapViewOfFile(myMappingHandle, FILE_MAP_READ, 0, 0, 0));
+	if (myData == nullptr)
+	{
+		Close();
+		throw std::runtime_error("MappedFile: could not map " + aPath.string());
+	}
+#else
+	const int fd = open(aPath.c_str(), O_RDONLY);
+	if (fd == -1)
+		throw std::runtime_error("MappedFile: could not open " + aPath.string());
+
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) == -1)
+	{
+		close(fd);
+		throw std::runtime_error("MappedFile: could not get the size of " + aPath.string());
+	}
+
+	mySize = static_cast<std::size_t>(fileStat.st_size);
+
+	if (mySize == 0) // empty files cannot be mapped
+	{
+		close(fd);
+		return;
+	}
+
+	void* data = mmap(nullptr, mySize, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd); // the mapping keeps its own reference to the file
+
+	if (data == MAP_FAILED)
+	{
+		mySize = 0;
+		throw std::runtime_error("MappedFile: could not map " + aPath.string());
+	}
+
+	madvise(data, mySize, MADV_SEQUENTIAL); // decoding mostly walks the file front to back
+
+	myData = static_cast<const std::byte*>(data);
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+MappedFile::MappedFile(MappedFile&& aOther) noexcept
+	: myData(std::exchange(aOther.myData, nullptr))
+	, mySize(std::exchange(aOther.mySize, 0))
+#ifdef DAISER_SYSTEM_WIN
+	, myFileHandle(std::exchange(aOther.myFileHandle, nullptr))
+	, myMappingHandle(std::exchange(aOther.myMappingHandle, nullptr))
+#endif
+{
+
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& aOther) noexcept
+{
+	if (this != &aOther)
+	{
+		Close();
+
+		myData			= std::exchange(aOther.myData, nullptr);
+		mySize			= std::exchange(aOther.mySize, 0);
+#ifdef DAISER_SYSTEM_WIN
+		myFileHandle	= std::exchange(aOther.myFileHandle, nullptr);
+		myMappingHandle	= std::exchange(aOther.myMappingHandle, nullptr);
+#endif
+	}
+
+	return *this;
+}
+
+void MappedFile::Close() noexcept
+{
+#ifdef DAISER_SYSTEM_WIN
+	if (myData != nullptr)
+		UnmapViewOfFile(myData);
+
+	if (myMappingHandle != nullptr)
+		CloseHandle(myMappingHandle);
+
+	if (myFileHandle != nullptr)
+		CloseHandle(myFileHandle);
+
+	myFileHandle	= nullptr;
+	myMappingHandle	= nullptr;
+#else
+	if (myData != nullptr)
+		munmap(const_cast<std::byte*>(myData), mySize);
+#endif
+
+	myData	= nullptr;
+	mySize	= 0;
+}
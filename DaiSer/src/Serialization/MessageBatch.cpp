@@ -0,0 +1,123 @@
+#include <DaiSer/Serialization/MessageBatch.h>
+
+#include <DaiSer/Utility/BitUtils.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstring>
+
+#ifndef DAISER_SYSTEM_WIN
+#	include <sys/uio.h>
+
+static_assert(sizeof(DaiSer::IoSlice) == sizeof(iovec) && offsetof(DaiSer::IoSlice, base) == offsetof(iovec, iov_base) &&
+	offsetof(DaiSer::IoSlice, length) == offsetof(iovec, iov_len), "IoSlice must have the same layout as iovec");
+#endif
+
+using namespace DaiSer;
+
+MessageBatch::MessageBatch(std::size_t aChunkSize)
+	: myChunkSize(aChunkSize)
+{
+	assert(aChunkSize > FRAME_HEADER_SIZE && "Chunks must be able to hold a frame!");
+}
+
+std::size_t MessageBatch::Gather(std::span<IoSlice> aOutSlices) const
+{
+	std::size_t numSlices = 0;
+	std::size_t offset = myFrontOffset;
+
+	for (auto it = myChunks.begin(); it != myChunks.end() && numSlices < aOutSlices.size(); ++it, offset = 0)
+	{
+		if (it->GetSize() != offset)
+			aOutSlices[numSlices++] = { it->GetData() + offset, it->GetSize() - offset };
+	}
+
+	return numSlices;
+}
+
+void MessageBatch::Consume(std::size_t aNumBytes)
+{
+	assert(aNumBytes <= myPendingBytes && "Cannot consume more bytes than are pending!");
+
+	myPendingBytes -= aNumBytes;
+
+	while (!myChunks.empty())
+	{
+		ByteBuffer& front = myChunks.front();
+
+		const std::size_t remaining = front.GetSize() - myFrontOffset;
+
+		if (aNumBytes < remaining || (remaining == 0 && myChunks.size() == 1))
+		{
+			myFrontOffset += aNumBytes;
+			return;
+		}
+
+		aNumBytes -= remaining;
+
+		front.Clear(); // keeps the capacity for the next frames
+		myFreeChunks.push_back(std::move(front));
+
+		myChunks.pop_front();
+		myFrontOffset = 0;
+	}
+}
+
+ByteBuffer& MessageBatch::BeginFrame(std::size_t aNumBytes)
+{
+	if (!myChunks.empty())
+	{
+		ByteBuffer& back = myChunks.back();
+
+		if (back.GetCapacity() - back.GetSize() >= aNumBytes)
+			return back;
+	}
+
+	ByteBuffer chunk;
+
+	if (!myFreeChunks.empty())
+	{
+		chunk = std::move(myFreeChunks.back());
+		myFreeChunks.pop_back();
+	}
+
+	chunk.Reserve(std::max(myChunkSize, aNumBytes));
+
+	return myChunks.emplace_back(std::move(chunk));
+}
+
+void MessageBatch::EndFrame(ByteBuffer& aChunk, std::size_t aFrameOffset, std::size_t aEndOffset)
+{
+	const std::size_t numBytes = aEndOffset - aFrameOffset - FRAME_HEADER_SIZE;
+	assert(numBytes <= UINT32_MAX && "Frame is too large!");
+
+	std::uint32_t length = static_cast<std::uint32_t>(numBytes);
+
+	if constexpr (std::endian::native == std::endian::big)
+		length = ByteSwap(length);
+
+	std::memcpy(aChunk.GetData() + aFrameOffset, &length, FRAME_HEADER_SIZE);
+
+	myPendingBytes += aEndOffset - aFrameOffset;
+}
+
+std::optional<ReadSerializer> FrameReader::Next()
+{
+	const std::span<const std::byte> remaining = GetRemaining();
+
+	if (remaining.size() < FRAME_HEADER_SIZE)
+		return std::nullopt;
+
+	std::uint32_t length;
+	std::memcpy(&length, remaining.data(), FRAME_HEADER_SIZE);
+
+	if constexpr (std::endian::native == std::endian::big)
+		length = ByteSwap(length);
+
+	if (remaining.size() - FRAME_HEADER_SIZE < length)
+		return std::nullopt;
+
+	myOffset += FRAME_HEADER_SIZE + length;
+
+	return ReadSerializer(remaining.subspan(FRAME_HEADER_SIZE, length));
+}
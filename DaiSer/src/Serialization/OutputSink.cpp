@@ -0,0 +1,113 @@
+#include <DaiSer/Serialization/OutputSink.h>
+
+#include <utility>
+
+using namespace DaiSer;
+
+ByteBuffer::ByteBuffer(std::size_t aCapacity)
+{
+	Reserve(aCapacity);
+}
+
+ByteBuffer::ByteBuffer(std::span<const std::byte> aBytes)
+{
+	Reserve(aBytes.size());
+
+	if (!aBytes.empty())
+		std::memcpy(myData.get(), aBytes.data(), aBytes.size());
+
+	mySize = aBytes.size();
+}
+
+ByteBuffer::ByteBuffer(const ByteBuffer& aOther)
+	: ByteBuffer(static_cast<std::span<const std::byte>>(aOther))
+{
+
+}
+
+ByteBuffer::ByteBuffer(ByteBuffer&& aOther) noexcept
+	: myData(std::move(aOther.myData))
+	, mySize(std::exchange(aOther.mySize, 0))
+	, myCapacity(std::exchange(aOther.myCapacity, 0))
+{
+
+}
+
+ByteBuffer& ByteBuffer::operator=(const ByteBuffer& aOther)
+{
+	if (this != &aOther)
+	{
+		Clear();
+		Reserve(aOther.mySize);
+
+		if (aOther.mySize != 0)
+			std::memcpy(myData.get(), aOther.myData.get(), aOther.mySize);
+
+		mySize = aOther.mySize;
+	}
+
+	return *this;
+}
+
+ByteBuffer& ByteBuffer::operator=(ByteBuffer&& aOther) noexcept
+{
+	myData		= std::move(aOther.myData);
+	mySize		= std::exchange(aOther.mySize, 0);
+	myCapacity	= std::exchange(aOther.myCapacity, 0);
+
+	return *this;
+}
+
+void ByteBuffer::Reserve(std::size_t aCapacity)
+{
+	if (aCapacity <= myCapacity)
+		return;
+
+	auto data = std::make_unique_for_overwrite<std::byte[]>(aCapacity);
+
+	if (mySize != 0)
+		std::memcpy(data.get(), myData.get(), mySize);
+
+	myData		= std::move(data);
+	myCapacity	= aCapacity;
+}
+
+void ByteBuffer::Resize(std::size_t aSize)
+{
+	if (aSize > myCapacity)
+		Grow(aSize);
+
+	mySize = aSize;
+}
+
+void ByteBuffer::ShrinkToFit()
+{
+	if (mySize == myCapacity)
+		return;
+
+	if (mySize == 0)
+	{
+		myData.reset();
+		myCapacity = 0;
+
+		return;
+	}
+
+	auto data = std::make_unique_for_overwrite<std::byte[]>(mySize);
+	std::memcpy(data.get(), myData.get(), mySize);
+
+	myData		= std::move(data);
+	myCapacity	= mySize;
+}
+
+std::vector<std::byte> ByteBuffer::ToVector() const
+{
+	return { myData.get(), myData.get() + mySize };
+}
+
+void ByteBuffer::Grow(std::size_t aMinCapacity)
+{
+	static constexpr std::size_t MIN_CAPACITY = 64;
+
+	Reserve(std::max({ aMinCapacity, myCapacity * 2, MIN_CAPACITY }));
+}
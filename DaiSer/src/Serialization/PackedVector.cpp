@@ -0,0 +1,279 @@
+#include <DaiSer/Serialization/PackedVector.h>
+
+#include <array>
+#include <bit>
+#include <utility>
+
+#include <DaiSer/Utility/VarInt.hpp>
+
+using namespace DaiSer;
+
+namespace
+{
+	constexpr std::uint8_t DELTA_FLAG	= 0x80;
+	constexpr std::uint8_t WIDTH_MASK	= 0x7F;
+
+	constexpr std::uint32_t MAX_WIDTH	= 64;
+
+	std::uint64_t LoadWord(const std::byte* aIn) noexcept
+	{
+		std::uint64_t word;
+		std::memcpy(&word, aIn, sizeof(word));
+
+		if constexpr (std::endian::native == std::endian::big)
+			word = ByteSwap(word);
+
+		return word;
+	}
+
+	/// Eight values of a width take exactly that many bytes, so every group of eight starts at a byte boundary
+	/// and the position of every value within its group is a constant
+	/// 
+	constexpr std::size_t GROUP_SIZE = 8;
+
+	template<std::uint32_t Width>
+	void PackGroup(const std::uint64_t* aValues, std::byte* aOut, std::size_t aNumBytes) noexcept
+	{
+		std::uint64_t words[Width / 8 + 2] = {};
+
+		[&]<std::size_t... Js>(std::index_sequence<Js...>)
+		{
+			([&]
+			{
+				constexpr std::size_t bit		= Js * Width;
+				constexpr std::size_t shift		= bit % 64;
+
+				words[bit / 64] |= aValues[Js] << shift;
+
+				if constexpr (shift + Width > 64)
+					words[bit / 64 + 1] |= aValues[Js] >> (64 - shift);
+			}(), ...);
+		}(std::make_index_sequence<GROUP_SIZE>{});
+
+		if constexpr (std::endian::native == std::endian::big)
+		{
+			for (std::uint64_t& word : words)
+				word = ByteSwap(word);
+		}
+
+		std::memcpy(aOut, words, aNumBytes);
+	}
+
+	/// Unpacks the group and adds the reference back, to the value itself or to the running value for delta
+	/// 
+	template<std::uint32_t Width, bool IsDelta>
+	void UnpackGroup(const std::byte* aIn, std::uint64_t aReference, std::uint64_t& aPrevious, std::uint64_t* aOutValues) noexcept
+	{
+		constexpr std::uint64_t mask = LowBitMask(Width);
+
+		[&]<std::size_t... Js>(std::index_sequence<Js...>)
+		{
+			([&]
+			{
+				constexpr std::size_t bit		= Js * Width;
+				constexpr std::uint32_t shift	= bit % 8;
+
+				std::uint64_t value = LoadWord(aIn + bit / 8) >> shift;
+
+				if constexpr (shift + Width > 64)
+					value |= LoadWord(aIn + bit / 8 + 8) << (64 - shift);
+
+				if constexpr (IsDelta)
+					aOutValues[Js] = aPrevious += (value & mask) + aReference;
+				else
+					aOutValues[Js] = (value & mask) + aReference;
+			}(), ...);
+		}(std::make_index_sequence<GROUP_SIZE>{});
+	}
+
+	/// Differences are taken from the value before rather than a running value, so that every offset of the
+	/// group is independent of the others
+	/// 
+	template<bool IsDelta>
+	void ToOffsets(const std::uint64_t* aValues, std::size_t aNumValues, std::uint64_t aReference, std::uint64_t aPrevious, std::uint64_t* aOutOffsets) noexcept
+	{
+		if constexpr (IsDelta)
+		{
+			aOutOffsets[0] = aValues[0] - aPrevious - aReference;
+
+			for (std::size_t i = 1; i < aNumValues; ++i)
+				aOutOffsets[i] = aValues[i] - aValues[i - 1] - aReference;
+		}
+		else
+		{
+			for (std::size_t i = 0; i < aNumValues; ++i)
+				aOutOffsets[i] = aValues[i] - aReference;
+		}
+	}
+
+	/// The width is a template parameter so that every shift and mask is a constant, which turns the groups
+	/// into straight-line code. Subtracting the reference is done in the same pass.
+	/// 
+	template<std::uint32_t Width, bool IsDelta>
+	void PackBits(const std::uint64_t* aValues, std::size_t aNumValues, std::uint64_t aReference, std::uint64_t aPrevious, std::byte* aOut) noexcept
+	{
+		if constexpr (Width != 0)
+		{
+			std::uint64_t offsets[GROUP_SIZE];
+			std::size_t i = 0;
+
+			for (; aNumValues - i >= GROUP_SIZE; i += GROUP_SIZE, aOut += Width)
+			{
+				ToOffsets<IsDelta>(aValues + i, GROUP_SIZE, aReference, i == 0 ? aPrevious : aValues[i - 1], offsets);
+				PackGroup<Width>(offsets, aOut, Width);
+			}
+
+			if (i != aNumValues)
+			{
+				std::fill_n(offsets, GROUP_SIZE, 0);
+
+				ToOffsets<IsDelta>(aValues + i, aNumValues - i, aReference, i == 0 ? aPrevious : aValues[i - 1], offsets);
+				PackGroup<Width>(offsets, aOut, ((aNumValues - i) * Width + 7) / 8);
+			}
+		}
+	}
+
+	/// The last group may be partial and is unpacked value by value, so that no load reaches past the padding
+	/// 
+	template<std::uint32_t Width, bool IsDelta>
+	void UnpackBits(const std::byte* aIn, std::size_t aNumValues, std::uint64_t aReference, std::uint64_t aPrevious, std::uint64_t* aOutValues) noexcept
+	{
+		std::size_t i = 0;
+
+		if constexpr (Width != 0)
+		{
+			for (; aNumValues - i >= GROUP_SIZE; i += GROUP_SIZE, aIn += Width)
+				UnpackGroup<Width, IsDelta>(aIn, aReference, aPrevious, aOutValues + i);
+		}
+
+		for (std::size_t j = 0; i + j < aNumValues; ++j)
+		{
+			std::uint64_t value = 0;
+
+			if constexpr (Width != 0)
+			{
+				const std::size_t bit		= j * Width;
+				const std::uint32_t shift	= static_cast<std::uint32_t>(bit % 8);
+
+				value = LoadWord(aIn + bit / 8) >> shift;
+
+				if (shift + Width > 64)
+					value |= LoadWord(aIn + bit / 8 + 8) << (64 - shift);
+
+				value &= LowBitMask(Width);
+			}
+
+			if constexpr (IsDelta)
+				aOutValues[i + j] = aPrevious += value + aReference;
+			else
+				aOutValues[i + j] = value + aReference;
+		}
+	}
+
+	using PackFunc		= void(*)(const std::uint64_t*, std::size_t, std::uint64_t, std::uint64_t, std::byte*) noexcept;
+	using UnpackFunc	= void(*)(const std::byte*, std::size_t, std::uint64_t, std::uint64_t, std::uint64_t*) noexcept;
+
+	template<bool IsDelta>
+	constexpr std::array<PackFunc, MAX_WIDTH + 1> PACK_FUNCS = []<std::size_t... Ws>(std::index_sequence<Ws...>)
+	{
+		return std::array<PackFunc, MAX_WIDTH + 1>{ &PackBits<static_cast<std::uint32_t>(Ws), IsDelta>... };
+	}(std::make_index_sequence<MAX_WIDTH + 1>{});
+
+	template<bool IsDelta>
+	constexpr std::array<UnpackFunc, MAX_WIDTH + 1> UNPACK_FUNCS = []<std::size_t... Ws>(std::index_sequence<Ws...>)
+	{
+		return std::array<UnpackFunc, MAX_WIDTH + 1>{ &UnpackBits<static_cast<std::uint32_t>(Ws), IsDelta>... };
+	}(std::make_index_sequence<MAX_WIDTH + 1>{});
+
+	std::size_t ReadBlockHeader(std::span<const std::byte> aInBytes, std::size_t aOffset, std::uint8_t& aOutHeader, std::uint64_t& aOutReference) noexcept
+	{
+		assert(aOffset < aInBytes.size() && "Not enough memory to read from!");
+
+		aOutHeader = static_cast<std::uint8_t>(aInBytes[aOffset]);
+
+		const std::size_t referenceBytes = DecodeVarInt(aInBytes.data() + aOffset + 1, aInBytes.size() - aOffset - 1, aOutReference);
+
+		assert(referenceBytes != 0 && "Malformed or truncated varint!");
+		assert((aOutHeader & WIDTH_MASK) <= MAX_WIDTH && "Malformed packed block!");
+
+		return 1 + referenceBytes;
+	}
+}
+
+PackedBlockPlan DaiSer::PlanPackedBlock(const std::uint64_t* aValues, std::size_t aNumValues, std::uint64_t aPrevious) noexcept
+{
+	std::uint64_t minValue = aValues[0];
+	std::uint64_t maxValue = aValues[0];
+
+	std::int64_t minDelta = static_cast<std::int64_t>(aValues[0] - aPrevious);
+	std::int64_t maxDelta = minDelta;
+
+	for (std::size_t i = 1; i < aNumValues; ++i) // the differences do not depend on each other and vectorize
+	{
+		const std::uint64_t value = aValues[i];
+		const std::int64_t delta = static_cast<std::int64_t>(value - aValues[i - 1]);
+
+		minValue = std::min(minValue, value);
+		maxValue = std::max(maxValue, value);
+		minDelta = std::min(minDelta, delta);
+		maxDelta = std::max(maxDelta, delta);
+	}
+
+	PackedBlockPlan plan;
+	plan.reference	= minValue;
+	plan.width		= static_cast<std::uint32_t>(std::bit_width(maxValue - minValue));
+
+	const std::uint32_t deltaWidth = static_cast<std::uint32_t>(std::bit_width(static_cast<std::uint64_t>(maxDelta) - static_cast<std::uint64_t>(minDelta)));
+
+	if (deltaWidth < plan.width)
+	{
+		plan.reference	= ZigZagEncode(minDelta);
+		plan.width		= deltaWidth;
+		plan.isDelta	= true;
+	}
+
+	return plan;
+}
+
+void DaiSer::EncodePackedBlock(const PackedBlockPlan& aPlan, const std::uint64_t* aValues, std::size_t aNumValues, std::uint64_t aPrevious, std::byte* aOutBytes) noexcept
+{
+	aOutBytes[0] = static_cast<std::byte>((aPlan.isDelta ? DELTA_FLAG : 0) | aPlan.width);
+
+	std::byte* packed = aOutBytes + 1 + EncodeVarInt(aPlan.reference, aOutBytes + 1);
+
+	if (aPlan.isDelta)
+		PACK_FUNCS<true>[aPlan.width](aValues, aNumValues, static_cast<std::uint64_t>(ZigZagDecode(aPlan.reference)), aPrevious, packed);
+	else
+		PACK_FUNCS<false>[aPlan.width](aValues, aNumValues, aPlan.reference, aPrevious, packed);
+}
+
+std::size_t DaiSer::DecodePackedBlock(std::span<const std::byte> aInBytes, std::size_t aOffset, std::size_t aNumValues, std::uint64_t aPrevious, std::uint64_t* aOutValues) noexcept
+{
+	std::uint8_t header = 0;
+	std::uint64_t reference = 0;
+
+	const std::size_t headerBytes	= ReadBlockHeader(aInBytes, aOffset, header, reference);
+	const std::uint32_t width		= header & WIDTH_MASK;
+	const std::size_t packedBytes	= (aNumValues * width + 7) / 8;
+
+	assert(aOffset + headerBytes + packedBytes + PACKED_PADDING <= aInBytes.size() && "Not enough memory to read from!");
+
+	const std::byte* packed = aInBytes.data() + aOffset + headerBytes;
+
+	if ((header & DELTA_FLAG) != 0)
+		UNPACK_FUNCS<true>[width](packed, aNumValues, static_cast<std::uint64_t>(ZigZagDecode(reference)), aPrevious, aOutValues);
+	else
+		UNPACK_FUNCS<false>[width](packed, aNumValues, reference, aPrevious, aOutValues);
+
+	return headerBytes + packedBytes;
+}
+
+std::size_t DaiSer::SkipPackedBlock(std::span<const std::byte> aInBytes, std::size_t aOffset, std::size_t aNumValues) noexcept
+{
+	std::uint8_t header = 0;
+	std::uint64_t reference = 0;
+
+	const std::size_t headerBytes = ReadBlockHeader(aInBytes, aOffset, header, reference);
+
+	return headerBytes + (aNumValues * (header & WIDTH_MASK) + 7) / 8;
+}
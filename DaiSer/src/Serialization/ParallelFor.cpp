@@ -0,0 +1,153 @@
+#include <DaiSer/Serialization/ParallelFor.h>
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <exception>
+
+using namespace DaiSer;
+
+namespace
+{
+	thread_local bool globalIsInParallelFor = false; // set on workers and on a caller while it takes part
+
+	/// Threads that are started once and run the work of one ParallelFor at a time along with its caller
+	/// 
+	class WorkerPool
+	{
+	public:
+		explicit WorkerPool(std::size_t aNumWorkers)
+		{
+			myThreads.reserve(aNumWorkers);
+
+			for (std::size_t i = 0; i < aNumWorkers; ++i)
+				myThreads.emplace_back([this]() { Loop(); });
+		}
+
+		/// The pool is never destroyed, joining threads while a library is unloaded can deadlock and the
+		/// workers only ever wait once their work is done
+		/// 
+		NODISC static WorkerPool& Get()
+		{
+			static WorkerPool& pool = *new WorkerPool(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+			return pool;
+		}
+
+		NODISC std::size_t GetNumWorkers() const noexcept { return myThreads.size(); }
+
+		/// Runs the work on every worker and the calling thread and returns once all of them are done, 
+		/// returns false without running anything if another thread is using the pool
+		/// 
+		NODISC bool TryRun(const std::function<void()>& aWork)
+		{
+			std::unique_lock runLock(myRunMutex, std::try_to_lock);
+
+			if (!runLock.owns_lock())
+				return false;
+
+			{
+				std::scoped_lock lock(myMutex);
+
+				myWork			= &aWork;
+				myNumBusy		= myThreads.size();
+				++myGeneration;
+			}
+
+			myWake.notify_all();
+
+			aWork();
+
+			std::unique_lock lock(myMutex);
+			myDone.wait(lock, [this]() { return myNumBusy == 0; });
+
+			myWork = nullptr;
+
+			return true;
+		}
+
+	private:
+		void Loop()
+		{
+			globalIsInParallelFor = true;
+
+			std::size_t generation = 0;
+			std::unique_lock lock(myMutex);
+
+			for (;;)
+			{
+				myWake.wait(lock, [&]() { return myGeneration != generation; });
+
+				generation = myGeneration;
+				const std::function<void()>& work = *myWork;
+
+				lock.unlock();
+				work();
+				lock.lock();
+
+				if (--myNumBusy == 0)
+					myDone.notify_one();
+			}
+		}
+
+		std::mutex						myRunMutex;
+		std::mutex						myMutex;
+		std::condition_variable			myWake;
+		std::condition_variable			myDone;
+		const std::function<void()>*	myWork			= nullptr;
+		std::size_t						myGeneration	= 0;
+		std::size_t						myNumBusy		= 0;
+		std::vector<std::thread>		myThreads;
+	};
+}
+
+void DaiSer::ParallelFor(std::size_t aNumTasks, const std::function<void(std::size_t)>& aTask)
+{
+	// nested calls run on the thread that makes them, the outer call already occupies every thread
+	if (aNumTasks <= 1 || globalIsInParallelFor || WorkerPool::Get().GetNumWorkers() == 0)
+	{
+		for (std::size_t i = 0; i < aNumTasks; ++i)
+			aTask(i);
+
+		return;
+	}
+
+	std::atomic<std::size_t> nextTask = 0;
+
+	std::exception_ptr exception;
+	std::mutex exceptionMutex;
+
+	const std::function<void()> work = [&]()
+	{
+		for (std::size_t i = nextTask.fetch_add(1, std::memory_order_relaxed); i < aNumTasks; i = nextTask.fetch_add(1, std::memory_order_relaxed))
+		{
+			try
+			{
+				aTask(i);
+			}
+			catch (...)
+			{
+				std::scoped_lock lock(exceptionMutex);
+
+				if (!exception)
+					exception = std::current_exception();
+
+				nextTask.store(aNumTasks, std::memory_order_relaxed); // no point in continuing
+			}
+		}
+	};
+
+	globalIsInParallelFor = true;
+
+	const bool isPooled = WorkerPool::Get().TryRun(work);
+
+	if (!isPooled) // another thread is using the pool
+		work();
+
+	globalIsInParallelFor = false;
+
+	if (exception)
+		std::rethrow_exception(exception);
+}
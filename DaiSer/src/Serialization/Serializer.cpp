@@ -1,10 +1,11 @@
 #include <DaiSer/Serialization/Serializer.h>
 
+#include <stdexcept>
+
 using namespace DaiSer;
 
 Serializer::Serializer(SerializerState aState)
 	: myState(aState)
-	, myBuffer()
 	, myOffset(0)
 {
 
@@ -16,33 +17,99 @@ WriteSerializer::WriteSerializer()
 
 }
 
+WriteSerializer::WriteSerializer(ByteBuffer&& aBuffer)
+	: Serializer(SerializerState::Write)
+	, myBuffer(std::move(aBuffer))
+{
+	myBuffer.Clear();
+}
+
+ByteBuffer WriteSerializer::MoveBuffer()
+{
+	myBuffer.Resize(myOffset);
+	myOffset = 0;
+
+	return std::move(myBuffer);
+}
+
 void WriteSerializer::ReserveBytesToFit(std::size_t aNumBytesToFit)
 {
-	myBuffer.resize(myBuffer.size() + aNumBytesToFit);
+	myBuffer.Reserve(myOffset + aNumBytesToFit);
 }
 
 void WriteSerializer::FitBufferToOffset()
 {
-	myBuffer.resize(myOffset);
-	myBuffer.shrink_to_fit();
+	myBuffer.Resize(myOffset);
+	myBuffer.ShrinkToFit();
+}
+
+void WriteSerializer::AppendChecksum()
+{
+	std::uint32_t checksum = Crc32c(GetBuffer());
+
+	if constexpr (std::endian::native == std::endian::big)
+		checksum = ByteSwap(checksum);
+
+	std::memcpy(myBuffer.Prepare(myOffset, CHECKSUM_SIZE), &checksum, CHECKSUM_SIZE);
+	myOffset += CHECKSUM_SIZE;
 }
 
 void WriteSerializer::Clear()
 {
-	myBuffer.clear();
+	myBuffer.Clear(); // keeps the capacity for the next message
 	myOffset = 0;
 }
 
+ReadSerializer::ReadSerializer(ByteBuffer&& aBuffer)
+	: Serializer(SerializerState::Read)
+	, myStorage(std::move(aBuffer))
+	, myBuffer(std::get<ByteBuffer>(myStorage))
+{
+
+}
+
 ReadSerializer::ReadSerializer(std::vector<std::byte>&& aBuffer)
 	: Serializer(SerializerState::Read)
+	, myStorage(std::move(aBuffer))
+	, myBuffer(std::get<std::vector<std::byte>>(myStorage))
+{
+
+}
+
+ReadSerializer::ReadSerializer(MappedFile&& aFile)
+	: Serializer(SerializerState::Read)
+	, myStorage(std::move(aFile))
+	, myBuffer(std::get<MappedFile>(myStorage))
 {
-	myBuffer = std::move(aBuffer);
+
 }
 
 ReadSerializer::ReadSerializer(std::span<const std::byte> aBuffer)
 	: Serializer(SerializerState::Read)
+	, myStorage()
+	, myBuffer(aBuffer)
 {
-	myBuffer = { aBuffer.begin(), aBuffer.end() };
+
+}
+
+ReadSerializer::ReadSerializer(ReadSerializer&& aOther) noexcept
+	: Serializer(SerializerState::Read)
+	, myStorage(std::move(aOther.myStorage)) // moving the storage keeps the heap memory, and therefore the view, intact
+	, myBuffer(std::exchange(aOther.myBuffer, {}))
+	, myStringTable(std::exchange(aOther.myStringTable, nullptr))
+{
+	myOffset = std::exchange(aOther.myOffset, 0);
+}
+
+ReadSerializer& ReadSerializer::operator=(ReadSerializer&& aOther) noexcept
+{
+	myStorage	= std::move(aOther.myStorage);
+	myBuffer	= std::exchange(aOther.myBuffer, {});
+	myOffset	= std::exchange(aOther.myOffset, 0);
+
+	myStringTable = std::exchange(aOther.myStringTable, nullptr);
+
+	return *this;
 }
 
 bool ReadSerializer::IsDone() const
@@ -50,34 +117,74 @@ bool ReadSerializer::IsDone() const
 	return myOffset == myBuffer.size();
 }
 
-std::size_t SerializeImpl<std::string>::Write(const std::string& aInData, std::vector<std::byte>& aOutBytes, std::size_t aOffset)
+void ReadSerializer::VerifyChecksum()
 {
-	aOutBytes.resize(aOffset + aInData.length() + 1);
-	memcpy_s(aOutBytes.data() + aOffset, aInData.length() + 1, aInData.c_str(), aInData.length() + 1);
-	assert(strlen(reinterpret_cast<const char*>(aOutBytes.data() + aOffset)) == aInData.length()); // make sure it went well
+	assert(myOffset == 0 && "Checksum must be verified before reading!");
+
+	if (myBuffer.size() < CHECKSUM_SIZE)
+		throw std::runtime_error("ReadSerializer: buffer is too small to hold a checksum");
+
+	const std::span<const std::byte> payload = myBuffer.first(myBuffer.size() - CHECKSUM_SIZE);
+
+	std::uint32_t expected;
+	std::memcpy(&expected, myBuffer.data() + payload.size(), CHECKSUM_SIZE);
 
-	return aInData.length() + 1;
+	if constexpr (std::endian::native == std::endian::big)
+		expected = ByteSwap(expected);
+
+	if (Crc32c(payload) != expected)
+		throw std::runtime_error("ReadSerializer: checksum does not match, the buffer is corrupt");
+
+	myBuffer = payload;
 }
-std::size_t SerializeImpl<std::string>::Read(std::string& aOutData, const std::vector<std::byte>& aInBytes, std::size_t aOffset)
+
+std::size_t SerializeImpl<std::string>::Read(std::string& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset)
 {
-	aOutData = reinterpret_cast<const char*>(aInBytes.data() + aOffset);
-	return aOutData.length() + 1;
+	return ReadString(aOutData, aInBytes, aOffset);
 }
 
-std::size_t SerializeImpl<std::wstring>::Write(const std::wstring& aInData, std::vector<std::byte>& aOutBytes, std::size_t aOffset)
+std::size_t SerializeImpl<std::string_view>::Read(std::string_view& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset)
 {
-	static constexpr std::size_t WCHAR_SIZE = sizeof(wchar_t);
+	if (StringTable* table = StringTable::GetActive())
+		return ReadTableString(aOutData, *table, aInBytes, aOffset);
 
-	aOutBytes.resize(aOffset + (aInData.length() + 1) * WCHAR_SIZE);
-	memcpy_s(aOutBytes.data() + aOffset, (aInData.length() + 1) * WCHAR_SIZE, aInData.c_str(), (aInData.length() + 1) * WCHAR_SIZE);
-	assert(wcslen(reinterpret_cast<const wchar_t*>(aOutBytes.data() + aOffset)) == aInData.length()); // make sure it went well
+	std::size_t length = 0;
+	const std::size_t prefixBytes = ReadStringLength(length, aInBytes, aOffset);
 
-	return (aInData.length() + 1) * WCHAR_SIZE;
+	assert(length <= aInBytes.size() - aOffset - prefixBytes && "Not enough memory to read from!");
+
+	aOutData = std::string_view(reinterpret_cast<const char*>(aInBytes.data() + aOffset + prefixBytes), length);
+
+	return prefixBytes + length;
 }
-std::size_t SerializeImpl<std::wstring>::Read(std::wstring& aOutData, const std::vector<std::byte>& aInBytes, std::size_t aOffset)
+
+std::size_t DaiSer::ReadTableString(std::string_view& aOutData, StringTable& aTable, std::span<const std::byte> aInBytes, std::size_t aOffset)
 {
-	static constexpr std::size_t WCHAR_SIZE = sizeof(wchar_t);
+	assert(aOffset <= aInBytes.size() && "Not enough memory to read from!");
+
+	std::uint64_t header = 0;
+	const std::size_t headerBytes = DecodeVarInt(aInBytes.data() + aOffset, aInBytes.size() - aOffset, header);
+
+	assert(headerBytes != 0 && "Malformed or truncated varint!");
+
+	if ((header & 1) != 0)
+	{
+		assert((header >> 1) < aTable.GetSize() && "String table does not match the writer!");
+		aOutData = aTable.Get(static_cast<std::size_t>(header >> 1));
+
+		return headerBytes;
+	}
 
-	aOutData = reinterpret_cast<const wchar_t*>(aOutData.data() + aOffset);
-	return (aOutData.length() + 1) * WCHAR_SIZE;
+	const std::size_t length = static_cast<std::size_t>(header >> 1);
+
+	assert(length <= aInBytes.size() - aOffset - headerBytes && "Not enough memory to read from!");
+
+	aOutData = aTable.Add({ reinterpret_cast<const char*>(aInBytes.data() + aOffset + headerBytes), length });
+
+	return headerBytes + length;
+}
+
+std::size_t SerializeImpl<std::wstring>::Read(std::wstring& aOutData, std::span<const std::byte> aInBytes, std::size_t aOffset)
+{
+	return ReadString(aOutData, aInBytes, aOffset);
 }
@@ -0,0 +1,49 @@
+#include <DaiSer/Serialization/Snapshot.h>
+
+#include <DaiSer/Serialization/FileSerializer.h>
+
+#include <stdexcept>
+
+using namespace DaiSer;
+
+void DaiSer::WriteSnapshotFile(std::span<const std::byte> aSnapshot, const std::filesystem::path& aPath)
+{
+	FileSink sink(aPath);
+
+	for (std::size_t offset = 0; offset < aSnapshot.size(); offset += FileSink::DEFAULT_CHUNK_SIZE) // stays within the chunk of the sink
+	{
+		const std::size_t numBytes = std::min(FileSink::DEFAULT_CHUNK_SIZE, aSnapshot.size() - offset);
+		std::memcpy(sink.Prepare(offset, numBytes), aSnapshot.data() + offset, numBytes);
+	}
+
+	sink.Close();
+}
+
+const std::byte* DaiSer::FindSnapshotRoot(std::span<const std::byte> aSnapshot, std::size_t aRootSize)
+{
+	if (aSnapshot.size() < sizeof(SnapshotHeader))
+		throw std::runtime_error("Snapshot: too small to hold a header");
+
+	if (reinterpret_cast<std::uintptr_t>(aSnapshot.data()) % SNAPSHOT_ALIGNMENT != 0)
+		throw std::runtime_error("Snapshot: memory is not aligned to SNAPSHOT_ALIGNMENT");
+
+	SnapshotHeader header;
+	std::memcpy(&header, aSnapshot.data(), sizeof(header));
+
+	if (header.magic != SNAPSHOT_MAGIC)
+		throw std::runtime_error("Snapshot: not a snapshot");
+
+	if (header.byteOrder != SNAPSHOT_BYTE_ORDER)
+		throw std::runtime_error("Snapshot: written on a machine of another byte order");
+
+	if (header.rootSize != aRootSize)
+		throw std::runtime_error("Snapshot: written with another root type");
+
+	if (header.size > aSnapshot.size())
+		throw std::runtime_error("Snapshot: truncated, the header describes more bytes than are available");
+
+	if (header.rootOffset < sizeof(SnapshotHeader) || header.rootOffset > header.size || header.rootSize > header.size - header.rootOffset)
+		throw std::runtime_error("Snapshot: root lies outside of the snapshot");
+
+	return aSnapshot.data() + header.rootOffset;
+}
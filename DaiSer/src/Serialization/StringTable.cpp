@@ -0,0 +1,180 @@
+#include <DaiSer/Serialization/StringTable.h>
+
+#include <DaiSer/Utility/PerfectHash.hpp>
+
+#include <cstring>
+#include <algorithm>
+#include <utility>
+
+using namespace DaiSer;
+
+namespace
+{
+	thread_local StringTable* locActiveTable = nullptr;
+
+	std::uint64_t LoadWord(const char* aData) noexcept
+	{
+		std::uint64_t word;
+		std::memcpy(&word, aData, sizeof(word));
+
+		return word;
+	}
+
+	std::uint32_t LoadHalfWord(const char* aData) noexcept
+	{
+		std::uint32_t halfWord;
+		std::memcpy(&halfWord, aData, sizeof(halfWord));
+
+		return halfWord;
+	}
+
+	/// Strings are hashed a word at a time, where the last word overlaps the one before it rather than
+	/// copying a partial word, so that the short strings that repeat take a handful of multiplications
+	/// 
+	std::size_t HashString(std::string_view aString) noexcept
+	{
+		const char* data		= aString.data();
+		const std::size_t size	= aString.size();
+
+		std::uint64_t hash = size;
+
+		if (size >= sizeof(std::uint64_t))
+		{
+			for (std::size_t index = 0; index < size - sizeof(std::uint64_t); index += sizeof(std::uint64_t))
+				hash = MixBits(hash ^ LoadWord(data + index));
+
+			hash = MixBits(hash ^ LoadWord(data + size - sizeof(std::uint64_t)));
+		}
+		else if (size >= sizeof(std::uint32_t))
+		{
+			hash = MixBits(hash ^ (static_cast<std::uint64_t>(LoadHalfWord(data)) << 32 | LoadHalfWord(data + size - sizeof(std::uint32_t))));
+		}
+		else if (size != 0)
+		{
+			hash = MixBits(hash ^ (static_cast<std::uint64_t>(static_cast<unsigned char>(data[0])) << 16 | 
+				static_cast<std::uint64_t>(static_cast<unsigned char>(data[size / 2])) << 8 | static_cast<unsigned char>(data[size - 1])));
+		}
+
+		return static_cast<std::size_t>(hash);
+	}
+}
+
+std::size_t StringTable::Find(std::string_view aString) const
+{
+	if (!IsStorable(aString) || myEntries.empty())
+		return NOT_FOUND;
+
+	const std::uint32_t entry = mySlots[FindSlot(aString, HashString(aString))];
+	return entry != 0 ? entry - 1 : NOT_FOUND;
+}
+
+std::string_view StringTable::Add(std::string_view aString)
+{
+	if (!IsStorable(aString) || myEntries.size() >= MAX_ENTRIES)
+		return aString;
+
+	const std::size_t hash = HashString(aString);
+	const std::size_t slot = mySlots.empty() ? 0 : FindSlot(aString, hash);
+
+	if (!mySlots.empty() && mySlots[slot] != 0)
+		return myEntries[mySlots[slot] - 1];
+
+	return Insert(aString, hash, slot);
+}
+
+std::size_t StringTable::FindOrAdd(std::string_view aString)
+{
+	if (!IsStorable(aString))
+		return NOT_FOUND;
+
+	const std::size_t hash = HashString(aString);
+	const std::size_t slot = mySlots.empty() ? 0 : FindSlot(aString, hash);
+
+	if (!mySlots.empty() && mySlots[slot] != 0)
+		return mySlots[slot] - 1;
+
+	if (myEntries.size() < MAX_ENTRIES)
+		(void)Insert(aString, hash, slot);
+
+	return NOT_FOUND;
+}
+
+void StringTable::Clear()
+{
+	myEntries.clear();
+	myHashes.clear();
+	std::fill(mySlots.begin(), mySlots.end(), 0);
+
+	myBlockIndex	= 0;
+	myBlockOffset	= 0;
+}
+
+StringTable* StringTable::GetActive() noexcept
+{
+	return locActiveTable;
+}
+
+std::size_t StringTable::FindSlot(std::string_view aString, std::size_t aHash) const noexcept
+{
+	const std::size_t mask = mySlots.size() - 1;
+
+	for (std::size_t slot = aHash & mask;; slot = (slot + 1) & mask)
+	{
+		const std::uint32_t entry = mySlots[slot];
+
+		if (entry == 0 || (myHashes[entry - 1] == aHash && myEntries[entry - 1] == aString))
+			return slot;
+	}
+}
+
+std::string_view StringTable::Insert(std::string_view aString, std::size_t aHash, std::size_t aSlot)
+{
+	if ((myEntries.size() + 1) * 2 > mySlots.size())
+	{
+		mySlots.assign(std::max(MIN_SLOTS, mySlots.size() * 2), 0);
+
+		const std::size_t mask = mySlots.size() - 1;
+
+		for (std::size_t i = 0; i < myEntries.size(); ++i)
+		{
+			std::size_t slot = myHashes[i] & mask;
+			while (mySlots[slot] != 0)
+				slot = (slot + 1) & mask;
+
+			mySlots[slot] = static_cast<std::uint32_t>(i + 1);
+		}
+
+		aSlot = FindSlot(aString, aHash);
+	}
+
+	if (BLOCK_SIZE - myBlockOffset < aString.size())
+	{
+		++myBlockIndex;
+		myBlockOffset = 0;
+	}
+
+	if (myBlockIndex == myBlocks.size()) // blocks kept by Clear are filled again first
+		myBlocks.emplace_back(std::make_unique<char[]>(BLOCK_SIZE));
+
+	char* copy = myBlocks[myBlockIndex].get() + myBlockOffset;
+	std::memcpy(copy, aString.data(), aString.size());
+	myBlockOffset += aString.size();
+
+	myEntries.emplace_back(copy, aString.size());
+	myHashes.emplace_back(aHash);
+
+	mySlots[aSlot] = static_cast<std::uint32_t>(myEntries.size());
+
+	return myEntries.back();
+}
+
+StringTableScope::StringTableScope(StringTable* aTable) noexcept
+	: myPrevious(std::exchange(locActiveTable, aTable))
+{
+
+}
+
+StringTableScope::~StringTableScope()
+{
+	locActiveTable = myPrevious;
+}
@@ -0,0 +1,304 @@
+#include <DaiSer/Serialization/Utf8.h>
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#	include <emmintrin.h>
+#	define DAISER_SIMD_UTF8 1
+#else
+#	define DAISER_SIMD_UTF8 0
+#endif
+
+using namespace DaiSer;
+
+namespace
+{
+	constexpr bool IS_UTF16 = (sizeof(wchar_t) == 2);
+
+	constexpr char32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+	constexpr std::size_t ASCII_BLOCK_SIZE = 16;
+
+	constexpr bool IsSurrogate(char32_t aValue) noexcept
+	{
+		return aValue >= 0xD800 && aValue <= 0xDFFF;
+	}
+
+	constexpr std::size_t CodePointSize(char32_t aCodePoint) noexcept
+	{
+		return aCodePoint < 0x80 ? 1 : aCodePoint < 0x800 ? 2 : aCodePoint < 0x10000 ? 3 : 4;
+	}
+
+	/// Returns whether the block of characters is all ASCII, converting it to bytes if so
+	/// 
+	bool EncodeAsciiBlock(const wchar_t* aText, std::byte* aOutBytes) noexcept
+	{
+#if DAISER_SIMD_UTF8
+		const __m128i* text = reinterpret_cast<const __m128i*>(aText);
+
+		if constexpr (IS_UTF16)
+		{
+			const __m128i first		= _mm_loadu_si128(text);
+			const __m128i second	= _mm_loadu_si128(text + 1);
+
+			if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(_mm_or_si128(first, second), _mm_set1_epi16(static_cast<short>(0xFF80))), _mm_setzero_si128())) != 0xFFFF)
+				return false;
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(aOutBytes), _mm_packus_epi16(first, second));
+		}
+		else
+		{
+			const __m128i a = _mm_loadu_si128(text);
+			const __m128i b = _mm_loadu_si128(text + 1);
+			const __m128i c = _mm_loadu_si128(text + 2);
+			const __m128i d = _mm_loadu_si128(text + 3);
+
+			const __m128i any = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+
+			if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(any, _mm_set1_epi32(~0x7F)), _mm_setzero_si128())) != 0xFFFF)
+				return false;
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(aOutBytes), _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+		}
+#else
+		std::uint32_t bits = 0;
+		for (std::size_t i = 0; i < ASCII_BLOCK_SIZE; ++i)
+			bits |= static_cast<std::uint32_t>(aText[i]);
+
+		if ((bits & ~0x7Fu) != 0)
+			return false;
+
+		for (std::size_t i = 0; i < ASCII_BLOCK_SIZE; ++i)
+			aOutBytes[i] = static_cast<std::byte>(aText[i]);
+#endif
+		return true;
+	}
+
+	/// Returns whether the block of bytes is all ASCII, converting it to characters if so
+	/// 
+	bool DecodeAsciiBlock(const std::byte* aBytes, wchar_t* aOutText) noexcept
+	{
+#if DAISER_SIMD_UTF8
+		const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(aBytes));
+
+		if (_mm_movemask_epi8(bytes) != 0)
+			return false;
+
+		__m128i* text = reinterpret_cast<__m128i*>(aOutText);
+
+		const __m128i low	= _mm_unpacklo_epi8(bytes, _mm_setzero_si128());
+		const __m128i high	= _mm_unpackhi_epi8(bytes, _mm_setzero_si128());
+
+		if constexpr (IS_UTF16)
+		{
+			_mm_storeu_si128(text,		low);
+			_mm_storeu_si128(text + 1,	high);
+		}
+		else
+		{
+			_mm_storeu_si128(text,		_mm_unpacklo_epi16(low, _mm_setzero_si128()));
+			_mm_storeu_si128(text + 1,	_mm_unpackhi_epi16(low, _mm_setzero_si128()));
+			_mm_storeu_si128(text + 2,	_mm_unpacklo_epi16(high, _mm_setzero_si128()));
+			_mm_storeu_si128(text + 3,	_mm_unpackhi_epi16(high, _mm_setzero_si128()));
+		}
+#else
+		std::uint64_t words[2];
+		std::memcpy(words, aBytes, ASCII_BLOCK_SIZE);
+
+		if (((words[0] | words[1]) & 0x8080808080808080ULL) != 0)
+			return false;
+
+		for (std::size_t i = 0; i < ASCII_BLOCK_SIZE; ++i)
+			aOutText[i] = static_cast<wchar_t>(aBytes[i]);
+#endif
+		return true;
+	}
+
+	/// Returns the code point that starts at the index and moves the index past it
+	/// 
+	char32_t NextCodePoint(std::wstring_view aText, std::size_t& aIndex) noexcept
+	{
+		if constexpr (IS_UTF16)
+		{
+			const char32_t unit = static_cast<char32_t>(aText[aIndex++]) & 0xFFFF;
+
+			if (!IsSurrogate(unit))
+				return unit;
+
+			if (unit <= 0xDBFF && aIndex < aText.size())
+			{
+				const char32_t low = static_cast<char32_t>(aText[aIndex]) & 0xFFFF;
+
+				if (low >= 0xDC00 && low <= 0xDFFF)
+				{
+					++aIndex;
+					return 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00);
+				}
+			}
+
+			return REPLACEMENT_CHARACTER;
+		}
+		else
+		{
+			const char32_t unit = static_cast<char32_t>(static_cast<std::uint32_t>(aText[aIndex++]));
+			return (unit > 0x10FFFF || IsSurrogate(unit)) ? REPLACEMENT_CHARACTER : unit;
+		}
+	}
+
+	/// Returns the code point that starts at the offset and moves the offset past it, a malformed sequence
+	/// is replaced and skipped by a single byte
+	/// 
+	char32_t NextCodePoint(std::span<const std::byte> aBytes, std::size_t& aOffset) noexcept
+	{
+		const std::uint8_t lead = static_cast<std::uint8_t>(aBytes[aOffset++]);
+
+		if (lead < 0x80)
+			return lead;
+
+		std::size_t numContinuations = 0;
+		char32_t codePoint = 0;
+		char32_t minCodePoint = 0; // smaller values are overlong encodings
+
+		if (lead >= 0xC2 && lead <= 0xDF)
+		{
+			numContinuations	= 1;
+			codePoint			= lead & 0x1F;
+			minCodePoint		= 0x80;
+		}
+		else if (lead >= 0xE0 && lead <= 0xEF)
+		{
+			numContinuations	= 2;
+			codePoint			= lead & 0x0F;
+			minCodePoint		= 0x800;
+		}
+		else if (lead >= 0xF0 && lead <= 0xF4)
+		{
+			numContinuations	= 3;
+			codePoint			= lead & 0x07;
+			minCodePoint		= 0x10000;
+		}
+		else
+		{
+			return REPLACEMENT_CHARACTER;
+		}
+
+		if (aBytes.size() - aOffset < numContinuations)
+			return REPLACEMENT_CHARACTER;
+
+		for (std::size_t i = 0; i < numContinuations; ++i)
+		{
+			const std::uint8_t continuation = static_cast<std::uint8_t>(aBytes[aOffset + i]);
+
+			if ((continuation & 0xC0) != 0x80)
+				return REPLACEMENT_CHARACTER;
+
+			codePoint = (codePoint << 6) | (continuation & 0x3F);
+		}
+
+		if (codePoint < minCodePoint || codePoint > 0x10FFFF || IsSurrogate(codePoint))
+			return REPLACEMENT_CHARACTER;
+
+		aOffset += numContinuations;
+
+		return codePoint;
+	}
+}
+
+std::size_t DaiSer::Utf8Size(std::wstring_view aText) noexcept
+{
+	std::size_t numBytes = 0;
+	std::size_t index = 0;
+
+	while (index < aText.size())
+	{
+		const std::size_t begin = index;
+
+		while (index < aText.size() && static_cast<std::uint32_t>(aText[index]) < 0x80) // the compiler vectorizes this well enough on its own
+			++index;
+
+		numBytes += index - begin;
+
+		if (index < aText.size())
+			numBytes += CodePointSize(NextCodePoint(aText, index));
+	}
+
+	return numBytes;
+}
+
+std::size_t DaiSer::EncodeUtf8(std::wstring_view aText, std::byte* aOutBytes) noexcept
+{
+	std::byte* out = aOutBytes;
+	std::size_t index = 0;
+
+	while (index < aText.size())
+	{
+		while (aText.size() - index >= ASCII_BLOCK_SIZE && EncodeAsciiBlock(aText.data() + index, out))
+		{
+			index	+= ASCII_BLOCK_SIZE;
+			out		+= ASCII_BLOCK_SIZE;
+		}
+
+		if (index == aText.size())
+			break;
+
+		const char32_t codePoint = NextCodePoint(aText, index);
+
+		if (codePoint < 0x80)
+		{
+			*out++ = static_cast<std::byte>(codePoint);
+		}
+		else if (codePoint < 0x800)
+		{
+			*out++ = static_cast<std::byte>(0xC0 | (codePoint >> 6));
+			*out++ = static_cast<std::byte>(0x80 | (codePoint & 0x3F));
+		}
+		else if (codePoint < 0x10000)
+		{
+			*out++ = static_cast<std::byte>(0xE0 | (codePoint >> 12));
+			*out++ = static_cast<std::byte>(0x80 | ((codePoint >> 6) & 0x3F));
+			*out++ = static_cast<std::byte>(0x80 | (codePoint & 0x3F));
+		}
+		else
+		{
+			*out++ = static_cast<std::byte>(0xF0 | (codePoint >> 18));
+			*out++ = static_cast<std::byte>(0x80 | ((codePoint >> 12) & 0x3F));
+			*out++ = static_cast<std::byte>(0x80 | ((codePoint >> 6) & 0x3F));
+			*out++ = static_cast<std::byte>(0x80 | (codePoint & 0x3F));
+		}
+	}
+
+	return static_cast<std::size_t>(out - aOutBytes);
+}
+
+std::size_t DaiSer::DecodeUtf8(std::span<const std::byte> aBytes, wchar_t* aOutText) noexcept
+{
+	wchar_t* out = aOutText;
+	std::size_t offset = 0;
+
+	while (offset < aBytes.size())
+	{
+		while (aBytes.size() - offset >= ASCII_BLOCK_SIZE && DecodeAsciiBlock(aBytes.data() + offset, out))
+		{
+			offset	+= ASCII_BLOCK_SIZE;
+			out		+= ASCII_BLOCK_SIZE;
+		}
+
+		if (offset == aBytes.size())
+			break;
+
+		const char32_t codePoint = NextCodePoint(aBytes, offset);
+
+		if (IS_UTF16 && codePoint >= 0x10000) // at least four bytes, so the pair fits
+		{
+			*out++ = static_cast<wchar_t>(0xD800 + ((codePoint - 0x10000) >> 10));
+			*out++ = static_cast<wchar_t>(0xDC00 + ((codePoint - 0x10000) & 0x3FF));
+		}
+		else
+		{
+			*out++ = static_cast<wchar_t>(codePoint);
+		}
+	}
+
+	return static_cast<std::size_t>(out - aOutText);
+}